@@ -0,0 +1,135 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+// Measures the per-frame cost of drawing many `gui::ChildFrame` widgets.
+//
+// Two variants are compared:
+//  - "by name": the child window is begun with its name string, which is how
+//    `ChildFrame::renderBegin()` used to work (the name is hashed every frame)
+//  - "by id": the library `ChildFrame`, begun with its pre-hashed identifier
+//
+// Usage: bench_child_frames [frames]
+
+#include <gui/ChildFrame.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Child frame that begins its window by name (previous behavior)
+class NamedChildFrame : public gui::ChildFrame
+{
+public:
+  NamedChildFrame(const gui::Vec2i& size) : ChildFrame{ {}, {0, 0}, size }
+  {
+  }
+
+  bool renderBegin() override
+  {
+    ImGui::SetNextWindowPos(getPosition().to<float>());
+    return ImGui::BeginChild(
+      getName().c_str(), getSize().to<float>(), ImGuiChildFlags_Borders);
+  }
+};
+
+// Child frame using the library implementation
+class IdChildFrame : public gui::ChildFrame
+{
+public:
+  IdChildFrame(const gui::Vec2i& size) : ChildFrame{ {}, {0, 0}, size }
+  {
+  }
+};
+
+struct Result
+{
+  double medianUs;
+  double meanUs;
+};
+
+template <typename ChildFrameType>
+Result runBenchmark(size_t numChildren, size_t numFrames)
+{
+  std::vector<std::unique_ptr<gui::Widget>> children;
+  children.reserve(numChildren);
+  for (size_t i = 0; i < numChildren; ++i)
+  {
+    children.emplace_back(std::make_unique<ChildFrameType>(gui::Vec2i{ 8, 8 }));
+  }
+
+  ImGui::CreateContext();
+  ImGuiIO& io = ImGui::GetIO();
+  io.DisplaySize = ImVec2(1280.0f, 720.0f);
+  io.DeltaTime = 1.0f / 60.0f;
+  io.Fonts->Build();
+
+  std::vector<double> frameTimes;
+  frameTimes.reserve(numFrames);
+
+  const size_t numWarmupFrames{ 10 };
+  for (size_t frame = 0; frame < numWarmupFrames + numFrames; ++frame)
+  {
+    const auto start{ std::chrono::steady_clock::now() };
+
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("Host", nullptr, ImGuiWindowFlags_NoDecoration);
+    for (auto& child : children)
+    {
+      child->draw();
+    }
+    ImGui::End();
+    ImGui::Render();
+
+    const auto end{ std::chrono::steady_clock::now() };
+    if (frame >= numWarmupFrames)
+    {
+      frameTimes.push_back(
+        std::chrono::duration<double, std::micro>(end - start).count());
+    }
+  }
+
+  ImGui::DestroyContext();
+
+  Result result{ 0.0, 0.0 };
+  if (!frameTimes.empty())
+  {
+    double total{ 0.0 };
+    for (double t : frameTimes)
+    {
+      total += t;
+    }
+    result.meanUs = total / static_cast<double>(frameTimes.size());
+    std::nth_element(frameTimes.begin(),
+      frameTimes.begin() + frameTimes.size() / 2, frameTimes.end());
+    result.medianUs = frameTimes[frameTimes.size() / 2];
+  }
+  return result;
+}
+
+int main(int argc, char** argv)
+{
+  const size_t numFrames{
+    argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 200U };
+
+  std::printf("%10s %10s %14s %14s\n",
+    "children", "variant", "median [us]", "mean [us]");
+  for (size_t numChildren : { 1000U, 10000U })
+  {
+    const Result byName{ runBenchmark<NamedChildFrame>(numChildren, numFrames) };
+    std::printf("%10zu %10s %14.1f %14.1f\n",
+      numChildren, "by name", byName.medianUs, byName.meanUs);
+
+    const Result byId{ runBenchmark<IdChildFrame>(numChildren, numFrames) };
+    std::printf("%10zu %10s %14.1f %14.1f\n",
+      numChildren, "by id", byId.medianUs, byId.meanUs);
+  }
+
+  return 0;
+}
@@ -0,0 +1,310 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+// Headless frame-loop benchmark
+// -----------------------------
+// Runs a `gui::Application` against `Backend_Null` for a fixed number of
+// frames and reports the cost of the wrapper itself: frame time percentiles,
+// heap allocations per frame, generated vertices/indices per frame and the
+// number of draw lists whose geometry changed from one frame to the next
+// (a static UI should not change any).
+//
+// Usage: bench_frame_loop [shape] [size] [frames]
+//   shape   wide   one frame with `size` child frames in a sizer (default)
+//           deep   one frame with sizers nested `size` levels deep
+//           frames `size` top-level frames
+//           plots  one frame with `size` child frames showing a plot
+//   size    number of widgets or nesting levels (default: 100)
+//   frames  number of measured frames (default: 1000)
+
+#include <gui/gui.hpp>
+#include <gui/Backend_Null.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// Allocation counting ---------------------------------------------------------
+
+static std::atomic<size_t> allocationCount_{ 0 };
+
+void* operator new(std::size_t size)
+{
+  allocationCount_.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+static void* imguiAlloc_(size_t size, void*)
+{
+  allocationCount_.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size);
+}
+
+static void imguiFree_(void* ptr, void*)
+{
+  std::free(ptr);
+}
+
+// Instrumented backend --------------------------------------------------------
+
+struct FrameSample
+{
+  double frameMs;
+  size_t allocations;
+  int vertices;
+  int indices;
+  int drawLists;
+  int drawListsChanged;
+};
+
+class BenchBackend : public gui::Backend_Null
+{
+  std::vector<FrameSample>& samples_;
+  size_t warmupFrames_;
+  std::chrono::steady_clock::time_point frameStart_;
+  size_t frameAllocations_;
+public:
+  BenchBackend(std::vector<FrameSample>& samples, size_t warmupFrames) :
+    samples_{ samples },
+    warmupFrames_{ warmupFrames },
+    frameStart_{},
+    frameAllocations_{ 0 }
+  {
+    CollectDrawStats = true;
+  }
+
+  bool NewFrame() override
+  {
+    frameStart_ = std::chrono::steady_clock::now();
+    frameAllocations_ = allocationCount_.load(std::memory_order_relaxed);
+    return Backend_Null::NewFrame();
+  }
+
+  void Render() override
+  {
+    // The draw list statistics are not part of the measured frame time
+    const auto frameEnd{ std::chrono::steady_clock::now() };
+    const size_t allocations{
+      allocationCount_.load(std::memory_order_relaxed) - frameAllocations_ };
+    Backend_Null::Render();
+
+    if (FrameCount <= warmupFrames_)
+    {
+      return;
+    }
+    const ImDrawData* drawData{ ImGui::GetDrawData() };
+    samples_.push_back(FrameSample{
+      std::chrono::duration<double, std::milli>(frameEnd - frameStart_).count(),
+      allocations,
+      drawData ? drawData->TotalVtxCount : 0,
+      drawData ? drawData->TotalIdxCount : 0,
+      static_cast<int>(DrawLists.size()),
+      DrawListsChanged });
+  }
+};
+
+// Widget tree shapes ----------------------------------------------------------
+
+class LabelFrame : public gui::ChildFrame
+{
+public:
+  void render() override
+  {
+    ImGui::Text(getName());
+  }
+};
+
+class PlotFrame : public gui::ChildFrame
+{
+  std::vector<float> x_;
+  std::vector<float> y_;
+public:
+  PlotFrame() : x_(256), y_(256)
+  {
+    for (size_t i = 0; i < x_.size(); ++i)
+    {
+      x_[i] = static_cast<float>(i) / static_cast<float>(x_.size());
+      y_[i] = 0.5f * std::sin(6.2831853f * x_[i]) + 0.5f;
+    }
+  }
+
+  void render() override
+  {
+#ifdef USE_IMPLOT
+    if (ImPlot::BeginPlot(getName().c_str(), ImVec2(-1, -1)))
+    {
+      ImPlot::PlotLine("line", x_.data(), y_.data(), static_cast<int>(x_.size()));
+      ImPlot::EndPlot();
+    }
+#else
+    ImGui::PlotLines(getName().c_str(), y_.data(), static_cast<int>(y_.size()));
+#endif
+  }
+};
+
+class HostFrame : public gui::Frame
+{
+public:
+  HostFrame(const std::string& shape, size_t size)
+  {
+    gui::LayoutBuilder builder;
+    if (shape == "deep")
+    {
+      for (size_t level = 0; level < size; ++level)
+      {
+        if (level % 2 == 0)
+        {
+          builder.beginVertical();
+        }
+        else
+        {
+          builder.beginHorizontal();
+        }
+        builder.add(std::make_unique<LabelFrame>());
+      }
+      for (size_t level = 0; level < size; ++level)
+      {
+        builder.end();
+      }
+    }
+    else
+    {
+      builder.beginVertical();
+      for (size_t i = 0; i < size; ++i)
+      {
+        if (shape == "plots")
+        {
+          builder.add(std::make_unique<PlotFrame>());
+        }
+        else
+        {
+          builder.add(std::make_unique<LabelFrame>());
+        }
+      }
+      builder.end();
+    }
+    setLayout(builder.build());
+  }
+};
+
+class TopLevelFrame : public gui::Frame
+{
+public:
+  void render() override
+  {
+    ImGui::Text(getName());
+  }
+};
+
+// Report ----------------------------------------------------------------------
+
+static double percentile_(std::vector<double> values, double p)
+{
+  if (values.empty())
+  {
+    return 0.0;
+  }
+  const size_t index{ std::min(values.size() - 1,
+    static_cast<size_t>(p * static_cast<double>(values.size()))) };
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+static void report_(
+  const std::string& shape, size_t size, const std::vector<FrameSample>& samples)
+{
+  std::vector<double> frameMs;
+  frameMs.reserve(samples.size());
+  double allocations{ 0.0 }, vertices{ 0.0 }, indices{ 0.0 };
+  double drawLists{ 0.0 }, drawListsChanged{ 0.0 };
+  for (const FrameSample& sample : samples)
+  {
+    frameMs.push_back(sample.frameMs);
+    allocations += static_cast<double>(sample.allocations);
+    vertices += sample.vertices;
+    indices += sample.indices;
+    drawLists += sample.drawLists;
+    drawListsChanged += sample.drawListsChanged;
+  }
+  const double count{ std::max<double>(1.0, static_cast<double>(samples.size())) };
+
+  std::printf("shape:              %s\n", shape.c_str());
+  std::printf("size:               %zu\n", size);
+  std::printf("frames:             %zu\n", samples.size());
+  std::printf("frame time p50:     %.4f ms\n", percentile_(frameMs, 0.50));
+  std::printf("frame time p99:     %.4f ms\n", percentile_(frameMs, 0.99));
+  std::printf("allocations/frame:  %.2f\n", allocations / count);
+  std::printf("vertices/frame:     %.0f\n", vertices / count);
+  std::printf("indices/frame:      %.0f\n", indices / count);
+  std::printf("draw lists/frame:   %.1f\n", drawLists / count);
+  std::printf("  changed/frame:    %.1f\n", drawListsChanged / count);
+}
+
+int main(int argc, char** argv)
+{
+  const std::string shape{ argc > 1 ? argv[1] : "wide" };
+  const size_t size{
+    argc > 2 ? static_cast<size_t>(std::strtoul(argv[2], nullptr, 10)) : 100U };
+  const size_t numFrames{
+    argc > 3 ? static_cast<size_t>(std::strtoul(argv[3], nullptr, 10)) : 1000U };
+  const size_t numWarmupFrames{ 10 };
+
+  if (shape != "wide" && shape != "deep" && shape != "frames" && shape != "plots")
+  {
+    std::fprintf(stderr, "Unknown shape: %s\n", shape.c_str());
+    return EXIT_FAILURE;
+  }
+
+  // Must be set before the ImGui context is created
+  ImGui::SetAllocatorFunctions(imguiAlloc_, imguiFree_);
+
+  gui::Application app{ "Benchmark", {1280, 720} };
+
+  std::vector<FrameSample> samples;
+  samples.reserve(numFrames);
+  auto backend{ std::make_unique<BenchBackend>(samples, numWarmupFrames) };
+  backend->Timeout = 0.0f;
+  backend->MaxFrames = numWarmupFrames + numFrames;
+  app.getWindow().setBackend(std::move(backend));
+
+  std::unique_ptr<HostFrame> hostFrame;
+  std::vector<std::unique_ptr<TopLevelFrame>> topLevelFrames;
+  if (shape == "frames")
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      topLevelFrames.emplace_back(std::make_unique<TopLevelFrame>());
+    }
+  }
+  else
+  {
+    hostFrame = std::make_unique<HostFrame>(shape, size);
+  }
+
+  app.run();
+
+  report_(shape, size, samples);
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+// Timer wakeup benchmark
+// ----------------------
+// Runs `count` periodic `timer::Timer`s for a few seconds and reports the
+// wakeup latency distribution (time between a deadline and the start of its
+// callback) and the process CPU use, normalized per 1k active timers. A
+// second pass measures the latency of one-shot timers.
+//
+// Usage: bench_timers [count] [period_us] [seconds]
+//   count      number of active timers (default: 1000)
+//   period_us  timer period in microseconds (default: 10000)
+//   seconds    measured duration (default: 2)
+
+#include <timer/Timer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// All callbacks run on the timer thread, so the samples need no lock
+static std::vector<double> latencyUs_;
+
+static double percentile_(std::vector<double>& values, double p)
+{
+  if (values.empty())
+  {
+    return 0.0;
+  }
+  const size_t index{ std::min(values.size() - 1,
+    static_cast<size_t>(p * static_cast<double>(values.size()))) };
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+static void reportLatency_(const char* label)
+{
+  std::printf("%s samples:      %zu\n", label, latencyUs_.size());
+  std::printf("%s latency p50:  %.1f us\n", label, percentile_(latencyUs_, 0.50));
+  std::printf("%s latency p99:  %.1f us\n", label, percentile_(latencyUs_, 0.99));
+  std::printf("%s latency p999: %.1f us\n", label, percentile_(latencyUs_, 0.999));
+}
+
+static double cpuSeconds_()
+{
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+// Periodic timer that records how late each tick is
+struct PeriodicProbe
+{
+  timer::Timer timer;
+  Clock::time_point startTime;
+  uint64_t ticks{ 0 };
+
+  void start(std::chrono::microseconds period)
+  {
+    // Catch up, so every deadline is called and tick `n` is due at
+    //  `startTime + (n + 1) * period`
+    timer.setOverrunPolicy(timer::Timer::OverrunPolicy::CatchUp);
+    startTime = Clock::now();
+    timer.start(period, [this, period]()
+      {
+        const Clock::time_point deadline{ startTime + period * static_cast<int64_t>(++ticks) };
+        latencyUs_.push_back(
+          std::chrono::duration<double, std::micro>(Clock::now() - deadline).count());
+      });
+  }
+};
+
+int main(int argc, char** argv)
+{
+  const size_t count{
+    argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 1000U };
+  const std::chrono::microseconds period{
+    argc > 2 ? std::strtol(argv[2], nullptr, 10) : 10000 };
+  const std::chrono::seconds duration{
+    argc > 3 ? std::strtol(argv[3], nullptr, 10) : 2 };
+
+  if (count == 0 || period.count() <= 0 || duration.count() <= 0)
+  {
+    std::fprintf(stderr, "Invalid arguments\n");
+    return EXIT_FAILURE;
+  }
+
+  // Periodic timers ---------------------------------------------------------
+  latencyUs_.reserve(count * static_cast<size_t>(duration / period + 1));
+  std::vector<std::unique_ptr<PeriodicProbe>> probes;
+  probes.reserve(count);
+
+  const double cpuStart{ cpuSeconds_() };
+  const Clock::time_point wallStart{ Clock::now() };
+  for (size_t i = 0; i < count; ++i)
+  {
+    probes.emplace_back(std::make_unique<PeriodicProbe>())->start(period);
+  }
+  std::this_thread::sleep_for(duration);
+  for (auto& probe : probes)
+  {
+    probe->timer.stop();
+  }
+  const double wallSeconds{
+    std::chrono::duration<double>(Clock::now() - wallStart).count() };
+  const double cpuPercent{ 100.0 * (cpuSeconds_() - cpuStart) / wallSeconds };
+
+  std::printf("timers:                %zu\n", count);
+  std::printf("period:                %lld us\n", static_cast<long long>(period.count()));
+  reportLatency_("periodic");
+  std::printf("cpu:                   %.2f %%\n", cpuPercent);
+  std::printf("cpu per 1k timers:     %.2f %%\n",
+    cpuPercent * 1000.0 / static_cast<double>(count));
+
+  // One-shot timers ---------------------------------------------------------
+  latencyUs_.clear();
+  std::vector<timer::Timer> oneShots(count);
+  const size_t rounds{ 10 };
+  for (size_t round = 0; round < rounds; ++round)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      // Spread the deadlines over one period
+      const std::chrono::microseconds delay{ period * static_cast<int64_t>(i)
+        / static_cast<int64_t>(count) + std::chrono::microseconds(100) };
+      const Clock::time_point deadline{ Clock::now() + delay };
+      oneShots[i].startOnce(delay, [deadline]()
+        {
+          latencyUs_.push_back(
+            std::chrono::duration<double, std::micro>(Clock::now() - deadline).count());
+        });
+    }
+    std::this_thread::sleep_for(period * 2);
+  }
+  for (auto& oneShot : oneShots)
+  {
+    oneShot.stop();
+  }
+  reportLatency_("one-shot");
+
+  return 0;
+}
@@ -6,6 +6,8 @@ option(USE_IMPLOT "Enable ImPlot" ON)
 option(USE_GUI_TEST_ENGINE "Enable Dear ImGui test engine" OFF)
 option(USE_GLAD "Enable GLAD OpenGL loader-generator" ON)
 option(USE_ROBOTO_WEBFONT "Enable Roboto webfont" ON)
+option(USE_GUI_PROFILER "Enable per-frame profiling zones" OFF)
+option(BUILD_BENCHMARKS "Build benchmarks" OFF)
 
 set(IMGUI_DIR ${PROJECT_SOURCE_DIR}/3rd-party/imgui)
 checkout_submodules(${IMGUI_DIR})
@@ -3,6 +3,7 @@
 
 #include <gl/gl.h>
 #include <gl/FrameBuffer.hpp>
+#include <gl/StateCache.hpp>
 #include <gui/gui.hpp>
 #include <timer/Timer.hpp>
 
@@ -20,6 +21,12 @@ public:
     timer_{},
     angle_{ 0.0f }
   {
+    // Run the timer callback on the GUI thread, so `angle_` is only accessed
+    //  from there. Posting a task also wakes up the main loop.
+    timer_.setExecutor([](timer::Timer::Callback callback)
+    {
+      gui::Application::getInstancePtr()->post(std::move(callback));
+    });
     timer_.start(100, [this]()
     {
       angle_ += 7.2f;
@@ -75,7 +82,7 @@ public:
 
     //make the viewport occupy the whole canvas
     const gui::Vec2i& canvasSize{ frameBuffer_->getSize() };
-    glViewport(0, 0, canvasSize.x, canvasSize.y);
+    gl::StateCache::getInstance().viewport(0, 0, canvasSize.x, canvasSize.y);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
 
@@ -120,20 +127,18 @@ class MainWindow : public gui::Frame
   BottomFrame bottomFrame_;
   LeftFrame leftFrame_;
 public:
-  void render() override
+  MainWindow()
   {
-    gui::VerticalSizer verticalSizer;
-
-    verticalSizer.addChild(&topFrame_, 3);
-    verticalSizer.addChild(&bottomFrame_);
-
-    gui::HorizontalSizer horizontalSizer;
-    horizontalSizer.addWithFixedSize(&leftFrame_, 200);
-    horizontalSizer.addChild(&verticalSizer, 3);
-
-    horizontalSizer.setSize(getContentSize());
-    horizontalSizer.setPosition(getContentMin());
-    horizontalSizer.draw();
+    // The widget tree is described once, the frames are members
+    setLayout(gui::LayoutBuilder{}
+      .beginHorizontal()
+        .addFixed(&leftFrame_, 200)
+        .beginVertical(3)
+          .add(&topFrame_, 3)
+          .add(&bottomFrame_)
+        .end()
+      .end()
+      .build());
   }
 };
 
@@ -142,6 +147,9 @@ int main(int argc, char** argv)
   // Create the application
   gui::Application app{ "GUI: Hello GL!" };
 
+  // Only render when there is input or the animation changes
+  app.setPowerSaving(true);
+
   // Create the main window
   MainWindow mainWindow;
 
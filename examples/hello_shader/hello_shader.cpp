@@ -4,6 +4,7 @@
 #include <gl/gl.h>
 #include <gl/FrameBuffer.hpp>
 #include <gl/Program.hpp>
+#include <gl/StateCache.hpp>
 #include <gui/gui.hpp>
 #include <timer/Timer.hpp>
 
@@ -28,6 +29,12 @@ public:
     timer_{},
     angle_{ 0.0f }
   {
+    // Run the timer callback on the GUI thread, so `angle_` is only accessed
+    //  from there. Posting a task also wakes up the main loop.
+    timer_.setExecutor([](timer::Timer::Callback callback)
+    {
+      gui::Application::getInstancePtr()->post(std::move(callback));
+    });
     timer_.start(100, [this]()
     {
       angle_ += 7.2f;
@@ -44,6 +51,9 @@ public:
 
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
+    gl::StateCache& state{ gl::StateCache::getInstance() };
+    state.onDeleteVertexArray(VAO);
+    state.onDeleteBuffer(VBO);
   }
 
   void initGL()
@@ -121,10 +131,11 @@ public:
       program_ = std::make_unique<gl::Program>(vertexShader, fragmentShader);
     }
 
+    gl::StateCache& state{ gl::StateCache::getInstance() };
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
 
-    glBindVertexArray(VAO);
+    state.bindVertexArray(VAO);
 
     // Define the vertex data
     const float factor{ std::cos(angle_ * 3.14159f / 180.0f) };
@@ -135,7 +146,7 @@ public:
          0.0f * factor,  0.75f, 0.0f,  0.0f, 0.0f, 1.0f  // Blue
     };
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    state.bindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER,
       sizeof(float)*vertices.size(), vertices.data(),
       GL_DYNAMIC_DRAW);
@@ -148,8 +159,8 @@ public:
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    state.bindBuffer(GL_ARRAY_BUFFER, 0);
+    state.bindVertexArray(0);
 
     // Set the initialized flag
     initialized_ = true;
@@ -197,7 +208,7 @@ public:
 
     //make the viewport occupy the whole canvas
     const gui::Vec2i& canvasSize{ frameBuffer_->getSize() };
-    glViewport(0, 0, canvasSize.x, canvasSize.y);
+    gl::StateCache::getInstance().viewport(0, 0, canvasSize.x, canvasSize.y);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
 
@@ -218,27 +229,30 @@ public:
          0.0f * factor_,  0.75f, 0.0f,  0.0f, 0.0f, 1.0f  // Blue
     };
 
+    // Binds go through the state cache, so it stays in sync with the
+    //  `gl::` classes drawing in the same context
+    gl::StateCache& state{ gl::StateCache::getInstance() };
+
     // Bind the VAO
-    glBindVertexArray(VAO);
+    state.bindVertexArray(VAO);
 
     // Bind the VBO
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    state.bindBuffer(GL_ARRAY_BUFFER, VBO);
 
     // Update the vertex data
     glBufferSubData(
       GL_ARRAY_BUFFER, 0, sizeof(float)*vertices.size(), vertices.data());
 
-    // Unbind the VBO
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
     // Use the shader program
     assert(program_ != nullptr);
     program_->use();
 
     // Draw the triangle
-    glBindVertexArray(VAO);
     glDrawArrays(GL_TRIANGLES, 0, 3);
-    glBindVertexArray(0);
+
+    // Unbind the VBO and the VAO
+    state.bindBuffer(GL_ARRAY_BUFFER, 0);
+    state.bindVertexArray(0);
 
     // Unuse the shader program
     program_->unuse();
@@ -269,20 +283,18 @@ class MainWindow : public gui::Frame
   BottomFrame bottomFrame_;
   LeftFrame leftFrame_;
 public:
-  void render() override
+  MainWindow()
   {
-    gui::VerticalSizer verticalSizer;
-
-    verticalSizer.addChild(&topFrame_, 3);
-    verticalSizer.addChild(&bottomFrame_);
-
-    gui::HorizontalSizer horizontalSizer;
-    horizontalSizer.addWithFixedSize(&leftFrame_, 200);
-    horizontalSizer.addChild(&verticalSizer, 3);
-
-    horizontalSizer.setSize(getContentSize());
-    horizontalSizer.setPosition(getContentMin());
-    horizontalSizer.draw();
+    // The widget tree is described once, the frames are members
+    setLayout(gui::LayoutBuilder{}
+      .beginHorizontal()
+        .addFixed(&leftFrame_, 200)
+        .beginVertical(3)
+          .add(&topFrame_, 3)
+          .add(&bottomFrame_)
+        .end()
+      .end()
+      .build());
   }
 };
 
@@ -291,6 +303,9 @@ int main(int argc, char** argv)
   // Create the application
   gui::Application app{ "GUI: Hello Shaders!" };
 
+  // Only render when there is input or the animation changes
+  app.setPowerSaving(true);
+
   // Create the main window
   MainWindow mainWindow;
 
@@ -3,6 +3,8 @@
 
 #include <gui/gui.hpp>
 
+#include <memory>
+
 class TopFrame : public gui::ChildFrame
 {
 public:
@@ -33,22 +35,18 @@ public:
 class MainWindow : public gui::Frame
 {
 public:
-  void render() override
+  MainWindow()
   {
-    gui::VerticalSizer verticalSizer;
-    TopFrame topFrame;
-    BottomFrame bottomFrame;
-    verticalSizer.addChild(&topFrame, 3);
-    verticalSizer.addChild(&bottomFrame);
-
-    gui::HorizontalSizer horizontalSizer;
-    LeftFrame leftFrame;
-    horizontalSizer.addWithFixedSize(&leftFrame, 200);
-    horizontalSizer.addChild(&verticalSizer, 3);
-
-    horizontalSizer.setSize(getContentSize());
-    horizontalSizer.setPosition(getContentMin());
-    horizontalSizer.draw();
+    // The widget tree is described once, the frame owns it
+    setLayout(gui::LayoutBuilder{}
+      .beginHorizontal()
+        .addFixed(std::make_unique<LeftFrame>(), 200)
+        .beginVertical(3)
+          .add(std::make_unique<TopFrame>(), 3)
+          .add(std::make_unique<BottomFrame>())
+        .end()
+      .end()
+      .build());
   }
 };
 
@@ -14,7 +14,11 @@ namespace gl
 {
   class Circle : public Shape
   {
-    std::unique_ptr<gl::Program> program_;
+    // Shared by all the instances, see `ProgramCache`
+    std::shared_ptr<gl::Program> program_;
+    Program::Uniform<std::array<float, 3>> uCenter_;
+    Program::Uniform<float> uRadius_;
+    Program::Uniform<std::array<float, 4>> uColor_;
     GLuint VBO, VAO;
     bool initialized_;
     size_t numSegments_;
@@ -32,12 +36,24 @@ namespace gl
 
     void drawGL() const override;
 
+    const Program* getProgram() const override { return program_.get(); }
+
+    void drawBatchedGL() const override;
+
     void setColor(float r, float g, float b, float a = 1.0f);
 
     void setCenter(float x, float y, float z = 0.0f);
 
     void setRadius(float radius);
 
+    size_t getNumSegments() const { return numSegments_; }
+
+    const std::array<float, 4>& getColor() const { return color_; }
+
+    const std::array<float, 3>& getCenter() const { return center_; }
+
+    float getRadius() const { return radius_; }
+
   private:
     std::vector<float> generateVertices_() const;
   };
@@ -0,0 +1,85 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <gl/gl.h>
+#include <gl/Shape.hpp>
+#include <gl/Program.hpp>
+
+#include <memory>
+#include <array>
+#include <vector>
+
+namespace gl
+{
+  // Many circles in one draw call
+  // -----------------------------
+  // Same shape as `Circle`, for scatter-like scenes with thousands of
+  // markers. Centers, radii and colors are kept in separate arrays
+  // (structure of arrays) and uploaded to one vertex buffer as per-instance
+  // attributes, so all the circles are drawn with a single instanced call.
+  // The buffer is only uploaded when the instances changed, orphaning the
+  // previous storage so the upload does not wait for the GPU.
+  //
+  // Without instanced arrays (OpenGL < 3.3 and no ARB_instanced_arrays), the
+  // circles are drawn one by one with the same shader.
+  class CircleBatch : public Shape
+  {
+    std::shared_ptr<gl::Program> program_;
+    GLuint VBO, VAO, instanceVBO_;
+    GLint centerLocation_, radiusLocation_, colorLocation_;
+    bool initialized_;
+    size_t numSegments_;
+    std::vector<float> centers_;  // x, y, z per circle
+    std::vector<float> radii_;
+    std::vector<float> colors_;   // r, g, b, a per circle
+    mutable bool dirty_;
+    mutable size_t capacity_;     // circles allocated in `instanceVBO_`
+    mutable size_t uploadedBytes_;
+  public:
+    CircleBatch(size_t numSegments = 36);
+
+    ~CircleBatch();
+
+    void initGL() override;
+
+    void deinitGL() override;
+
+    void drawGL() const override;
+
+    const Program* getProgram() const override { return program_.get(); }
+
+    void drawBatchedGL() const override;
+
+    // Draw calls issued by `drawGL()`, 1 with instanced arrays
+    size_t getDrawCallCount() const;
+
+    // Bytes uploaded to the instance buffer since `initGL()`
+    size_t getUploadedBytes() const { return uploadedBytes_; }
+
+    // Add a circle, returns its index
+    size_t add(
+      const std::array<float, 3>& center, float radius,
+      const std::array<float, 4>& color = { 1.0f, 0.0f, 0.0f, 1.0f });
+
+    // Change the number of circles, new circles are red with unit radius
+    void resize(size_t count);
+
+    void reserve(size_t count);
+
+    void clear();
+
+    size_t size() const { return radii_.size(); }
+
+    void setColor(size_t index, float r, float g, float b, float a = 1.0f);
+
+    void setCenter(size_t index, float x, float y, float z = 0.0f);
+
+    void setRadius(size_t index, float radius);
+
+  private:
+    std::vector<float> generateVertices_() const;
+    void upload_() const;
+  };
+} // namespace gl
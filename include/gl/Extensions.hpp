@@ -0,0 +1,77 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <gl/gl.h>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# define GL_EXTENSIONS_APIENTRY_ __stdcall
+#else
+# define GL_EXTENSIONS_APIENTRY_
+#endif
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+# define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+# define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+# define GL_ALREADY_SIGNALED 0x911A
+# define GL_TIMEOUT_EXPIRED 0x911B
+# define GL_CONDITION_SATISFIED 0x911C
+# define GL_WAIT_FAILED 0x911D
+#endif
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+# define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+# define GL_PROGRAM_BINARY_LENGTH 0x8741
+# define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+namespace gl
+{
+  // OpenGL entry points newer than the loaded core profile
+  // ------------------------------------------------------
+  // The GL loader only covers OpenGL 3.1. Functions from later versions (or
+  // their ARB extensions) are loaded here once a context is current, and
+  // stay null when the context does not support them. Check the `has*()`
+  // helpers before use and keep a fallback path.
+  //
+  // Usage:
+  // ```cpp
+  // glfwMakeContextCurrent(window);
+  // gl::Extensions::load(glfwGetProcAddress);
+  // if (gl::Extensions::get().hasSync()) { ... }
+  // ```
+  struct Extensions
+  {
+    using Proc = void (*)();
+    using GetProcAddress = Proc (*)(const char* name);
+
+    // Sync objects (OpenGL 3.2, ARB_sync)
+    GLsync (GL_EXTENSIONS_APIENTRY_* FenceSync)(GLenum condition, GLbitfield flags) = nullptr;
+    GLenum (GL_EXTENSIONS_APIENTRY_* ClientWaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout) = nullptr;
+    void (GL_EXTENSIONS_APIENTRY_* DeleteSync)(GLsync sync) = nullptr;
+
+    bool hasSync() const { return FenceSync && ClientWaitSync && DeleteSync; }
+
+    // Instanced arrays (OpenGL 3.3, ARB_instanced_arrays)
+    void (GL_EXTENSIONS_APIENTRY_* VertexAttribDivisor)(GLuint index, GLuint divisor) = nullptr;
+
+    bool hasInstancedArrays() const { return VertexAttribDivisor != nullptr; }
+
+    // Program binaries (OpenGL 4.1, ARB_get_program_binary), only loaded if
+    //  the driver supports at least one binary format
+    void (GL_EXTENSIONS_APIENTRY_* GetProgramBinary)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary) = nullptr;
+    void (GL_EXTENSIONS_APIENTRY_* ProgramBinary)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length) = nullptr;
+    void (GL_EXTENSIONS_APIENTRY_* ProgramParameteri)(GLuint program, GLenum pname, GLint value) = nullptr;
+
+    bool hasProgramBinary() const { return GetProgramBinary && ProgramBinary && ProgramParameteri; }
+
+    // Load the entry points of the current context, replacing the ones
+    //  previously loaded
+    static void load(GetProcAddress getProcAddress);
+
+    // Entry points loaded by the last `load()`, all null before
+    static const Extensions& get();
+  };
+
+} // namespace gl
@@ -3,34 +3,155 @@
 
 #pragma once
 
+#include <gl/gl.h>
 #include <gl/Shader.hpp>
 
 #include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 
 namespace gl
 {
+  namespace detail
+  {
+    // Uniform types supported by `Program::Uniform<T>`
+    template <typename T>
+    struct UniformType;
+
+    template <>
+    struct UniformType<float>
+    {
+      static constexpr GLenum glType{ GL_FLOAT };
+      static constexpr int size{ 1 };
+      static const float* data(const float& value) { return &value; }
+    };
+
+    template <>
+    struct UniformType<std::array<float, 2>>
+    {
+      static constexpr GLenum glType{ GL_FLOAT_VEC2 };
+      static constexpr int size{ 2 };
+      static const float* data(const std::array<float, 2>& value) { return value.data(); }
+    };
+
+    template <>
+    struct UniformType<std::array<float, 3>>
+    {
+      static constexpr GLenum glType{ GL_FLOAT_VEC3 };
+      static constexpr int size{ 3 };
+      static const float* data(const std::array<float, 3>& value) { return value.data(); }
+    };
+
+    template <>
+    struct UniformType<std::array<float, 4>>
+    {
+      static constexpr GLenum glType{ GL_FLOAT_VEC4 };
+      static constexpr int size{ 4 };
+      static const float* data(const std::array<float, 4>& value) { return value.data(); }
+    };
+  } // namespace detail
+
   class Program
   {
+    // Active uniform, introspected after `link()`
+    struct UniformInfo
+    {
+      int location;
+      GLenum type; // GL_NONE if unknown, not checked
+      std::array<float, 4> value; // last value set through this program
+      bool hasValue;
+    };
+
     unsigned program_;
     std::vector<Shader> shaders_;
+    mutable std::vector<UniformInfo> uniforms_;
+    // Names accepted by `findUniform_()` and their index into `uniforms_`,
+    //  -1 for inactive names. Array elements are added when first used.
+    mutable std::vector<std::pair<std::string, int>> uniformNames_;
+    // Open addressing hash table: name hash and index into `uniformNames_`,
+    //  -1 for empty slots
+    mutable std::vector<std::pair<uint32_t, int>> uniformTable_;
   public:
+    // Handle to a uniform, resolved once by `getUniform()`. Setting the
+    //  value does not look up the name, and the GL call is skipped when the
+    //  value did not change. A handle to an inactive uniform (e.g. removed
+    //  by the compiler) does nothing.
+    template <typename T>
+    class Uniform
+    {
+      const Program* program_;
+      int index_;
+    public:
+      Uniform() : program_{ nullptr }, index_{ -1 } {}
+      Uniform(const Program* program, int index) : program_{ program }, index_{ index } {}
+
+      bool isActive() const { return index_ >= 0; }
+
+      // The program must be in use
+      void set(const T& value) const
+      {
+        if (index_ >= 0)
+        {
+          program_->setUniform_(index_, detail::UniformType<T>::data(value),
+            detail::UniformType<T>::size);
+        }
+      }
+    };
+
     Program();
     ~Program();
 
     Program(const std::string& vertexShader, const std::string& fragmentShader);
 
+    Program(const Program&) = delete;
+    Program& operator=(const Program&) = delete;
+
     void attachShader(Shader shader);
+    // Compile and attach a vertex and a fragment shader, without linking
+    void attachShaders(const std::string& vertexShader, const std::string& fragmentShader);
     void link();
     void use() const;
     void unuse() const;
 
+    // Get a handle to a uniform, `name` as in GLSL (e.g. "uLight0.position",
+    //  "uColors[2]"). Throws `std::invalid_argument` if the uniform is
+    //  active with a different type.
+    template <typename T>
+    Uniform<T> getUniform(const char* name) const
+    {
+      const int index{ findUniform_(name) };
+      checkUniformType_(index, detail::UniformType<T>::glType, name);
+      return Uniform<T>{ this, index };
+    }
+
+    // Set a uniform by name, the program must be in use. The values are
+    //  cached by the program, so uniforms must not be changed with direct
+    //  glUniform calls.
     void setUniform1f(const char* name, float value) const;
     void setUniform2f(const char* name, const std::array<float,2>& value) const;
     void setUniform3f(const char* name, const std::array<float,3>& value) const;
     void setUniform4f(const char* name, const std::array<float,4>& value) const;
 
     unsigned get() const { return program_; }
+
+    // Linked program binary, requires `Extensions::hasProgramBinary()`.
+    //  Returns an empty vector if the driver does not provide one.
+    std::vector<uint8_t> getBinary(GLenum& format) const;
+
+    // Replace the program with a binary from `getBinary()`. Returns false if
+    //  the driver rejects it (e.g. after a driver update), the program must
+    //  then be built from sources.
+    bool loadBinary(GLenum format, const void* data, size_t size);
+
+  private:
+    void introspectUniforms_();
+    int findUniform_(const char* name) const;
+    // Name of the first element of every array in `name`
+    static std::string firstElementName_(const char* name);
+    void addUniformName_(std::string name, int index) const;
+    void insertUniformName_(size_t nameIndex) const;
+    void checkUniformType_(int index, GLenum type, const char* name) const;
+    void setUniform_(int index, const float* value, int size) const;
   };
 } // namespace gl
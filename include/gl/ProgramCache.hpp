@@ -0,0 +1,85 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <gl/Program.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gl
+{
+  // Shared shader programs
+  // ----------------------
+  // Programs built from the same sources are compiled once and shared by
+  // all the users (e.g. every `Circle`). The cache only keeps weak
+  // references: a program is deleted when its last user releases it, and
+  // compiled again on the next request.
+  //
+  // Optionally, linked program binaries are stored in a directory so later
+  // runs skip the compilation. Binaries rejected by the driver (e.g. after a
+  // driver update) are rebuilt from sources and overwritten.
+  //
+  // Programs belong to the current OpenGL context, call from the thread
+  // that owns it.
+  class ProgramCache
+  {
+  public:
+    // Vertex attribute names and the locations bound before linking
+    using AttributeLocations = std::vector<std::pair<std::string, GLuint>>;
+
+    static ProgramCache& getInstance();
+
+    // Get the program for the given sources and attribute locations,
+    //  building it if needed. Throws `std::runtime_error` if the shaders do
+    //  not compile or link. Shared programs must not be relinked.
+    std::shared_ptr<Program> get(
+      const std::string& vertexShader, const std::string& fragmentShader,
+      const AttributeLocations& attributeLocations = {});
+
+    // Directory for program binaries, empty to disable them (default). It
+    //  has no effect if the driver does not support program binaries.
+    void setBinaryDirectory(const std::string& directory) { binaryDirectory_ = directory; }
+    const std::string& getBinaryDirectory() const { return binaryDirectory_; }
+
+    // Number of programs alive
+    size_t size() const;
+
+  private:
+    struct Key
+    {
+      size_t glslVersion;
+      std::string vertexShader;
+      std::string fragmentShader;
+      AttributeLocations attributeLocations;
+
+      bool operator==(const Key& other) const
+      {
+        return glslVersion == other.glslVersion
+          && vertexShader == other.vertexShader
+          && fragmentShader == other.fragmentShader
+          && attributeLocations == other.attributeLocations;
+      }
+    };
+
+    struct KeyHash
+    {
+      size_t operator()(const Key& key) const { return static_cast<size_t>(hash_(key)); }
+    };
+
+    ProgramCache() = default;
+
+    static uint64_t hash_(const Key& key);
+    std::shared_ptr<Program> build_(const Key& key) const;
+    std::string binaryPath_(const Key& key) const;
+
+    std::unordered_map<Key, std::weak_ptr<Program>, KeyHash> programs_;
+    std::string binaryDirectory_;
+  };
+
+} // namespace gl
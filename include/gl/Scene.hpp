@@ -0,0 +1,108 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <gl/Shape.hpp>
+#include <gl/Circle.hpp>
+#include <gl/CircleBatch.hpp>
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace gl
+{
+  // Batched scene of shapes
+  // -----------------------
+  // Draws many heterogeneous shapes with few state changes:
+  //  - Circles are merged into shared instance buffers (`CircleBatch`), one
+  //    per number of segments and usage, drawn with one call per batch.
+  //  - The other shapes are sorted by program (`Shape::getProgram()`), so
+  //    each program is made current once and the shapes are drawn with
+  //    `Shape::drawBatchedGL()`. Shapes sharing a mesh (e.g. spheres) also
+  //    keep their vertex array bound, see `StateCache`.
+  //
+  // Shapes with the same program keep the order they were added in, but
+  // shapes with different programs may be drawn in any order: use depth
+  // (z) to order overlapping shapes.
+  //
+  // Merged circles are read from the shapes: dynamic ones on every
+  // `drawGL()`, static ones only when the scene changed or after
+  // `invalidate()`.
+  class Scene
+  {
+  public:
+    enum class Usage
+    {
+      Static,   // rarely modified, call `invalidate()` after a change
+      Dynamic,  // may change every frame
+    };
+
+    struct Stats
+    {
+      size_t shapes;        // shapes in the scene
+      size_t drawCalls;     // draw calls issued
+      size_t stateChanges;  // binds issued (not elided by `StateCache`)
+      size_t uploadedBytes; // bytes uploaded to vertex buffers
+    };
+
+    Scene();
+    ~Scene();
+
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    // Shapes are initialized by the scene, and when added if the scene is
+    //  already initialized
+    void add(std::shared_ptr<Shape> shape, Usage usage = Usage::Dynamic);
+
+    void remove(const std::shared_ptr<Shape>& shape);
+
+    void clear();
+
+    size_t size() const { return entries_.size(); }
+
+    // Read the static shapes again on the next `drawGL()`
+    void invalidate() { staticDirty_ = true; }
+
+    void initGL();
+
+    void deinitGL();
+
+    void drawGL();
+
+    // Counters of the last `drawGL()`, state changes are the `StateCache`
+    //  calls issued. Shapes without a program count as one draw call.
+    const Stats& getStats() const { return stats_; }
+
+  private:
+    struct Entry
+    {
+      std::shared_ptr<Shape> shape;
+      Usage usage;
+      const Circle* circle; // merged into a batch if not null
+    };
+
+    // Draw list item, `batch` is set for the merged circles
+    struct Item
+    {
+      const Shape* shape;
+      const CircleBatch* batch;
+    };
+
+    using BatchKey = std::pair<size_t, Usage>; // number of segments, usage
+
+    std::vector<Entry> entries_;
+    std::map<BatchKey, std::unique_ptr<CircleBatch>> batches_;
+    std::vector<Item> drawList_;
+    Stats stats_;
+    bool initialized_;
+    bool staticDirty_;
+    bool drawListDirty_;
+
+    void fillBatches_();
+    void sortDrawList_();
+  };
+} // namespace gl
@@ -5,6 +5,8 @@
 
 namespace gl
 {
+  class Program;
+
   class Shape
   {
   public:
@@ -15,5 +17,15 @@ namespace gl
     virtual void deinitGL() {};
 
     virtual void drawGL() const {};
+
+    // Program used by `drawGL()`, null if the shape does not draw with a
+    //  single program. `Scene` draws the shapes sharing a program in a row.
+    virtual const Program* getProgram() const { return nullptr; }
+
+    // Same as `drawGL()` but expects the program from `getProgram()` in use
+    //  and leaves it in use, with the shape's vertex array bound, so the next
+    //  shape of the same kind skips the binds (see `StateCache`). The caller
+    //  restores the state when the batch is done, as `Scene` does.
+    virtual void drawBatchedGL() const { drawGL(); }
   };
 } // namespace gl
@@ -12,10 +12,33 @@
 
 namespace gl
 {
+  // Lit sphere
+  // ----------
+  // The unit sphere meshes are indexed and shared by all the spheres with
+  // the same tessellation. Each sphere has a few levels of detail (the
+  // given tessellation, then halved) and draws the coarsest one that still
+  // looks round at its size on screen.
   class Sphere : public Shape
   {
-    std::unique_ptr<gl::Program> program_;
-    GLuint VBO, VAO;
+  public:
+    // Number of levels of detail, each one halves the tessellation
+    static constexpr size_t kLevelsOfDetail{ 4 };
+
+  private:
+    struct Mesh;
+
+    // Shared by all the instances, see `ProgramCache`
+    std::shared_ptr<gl::Program> program_;
+    Program::Uniform<std::array<float, 3>> uCenter_;
+    Program::Uniform<float> uRadius_;
+    Program::Uniform<std::array<float, 4>> uObjectColor_;
+    Program::Uniform<std::array<float, 4>> uAmbientLightColor_;
+    Program::Uniform<std::array<float, 4>> uLight0AmbientColor_;
+    Program::Uniform<std::array<float, 4>> uLight0DiffuseColor_;
+    Program::Uniform<std::array<float, 4>> uLight0SpecularColor_;
+    Program::Uniform<std::array<float, 3>> uLight0Position_;
+    std::array<std::shared_ptr<const Mesh>, kLevelsOfDetail> meshes_;
+    mutable size_t levelOfDetail_;
     bool initialized_;
     size_t latitudes_;
     size_t longitudes_;
@@ -33,13 +56,21 @@ namespace gl
 
     void drawGL() const override;
 
+    const Program* getProgram() const override { return program_.get(); }
+
+    void drawBatchedGL() const override;
+
     void setColor(float r, float g, float b, float a = 1.0f);
 
     void setCenter(float x, float y, float z = 0.0f);
 
     void setRadius(float radius);
 
+    // Level of detail used by the last `drawGL()`, 0 is the finest
+    size_t getLevelOfDetail() const { return levelOfDetail_; }
+
   private:
-    std::vector<float> generateVertices_() const;
+    static std::shared_ptr<const Mesh> getMesh_(size_t latitudes, size_t longitudes);
+    size_t selectLevelOfDetail_() const;
   };
 } // namespace gl
@@ -0,0 +1,111 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <gl/gl.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gl
+{
+  // Cache of the OpenGL bindings
+  // ----------------------------
+  // Tracks the current program, vertex array, buffers, framebuffers,
+  // viewport and 2D textures, and skips the calls that would set the value
+  // already current. The `gl::` classes bind through it. `Shape::drawGL()`
+  // still restores the default bindings, but batched drawing (see `Scene`)
+  // leaves them bound between shapes, so drawing the same kind of shape
+  // again only issues the draw call and the changed uniforms.
+  //
+  // The cache only knows about the calls made through it: code that binds
+  // with direct GL calls (e.g. the ImGui renderer) must be followed by
+  // `invalidate()`. The GUI backend invalidates it at the start of every
+  // frame. Deleting a bound object unbinds it, so deletions must be
+  // reported with the `onDelete*()` functions.
+  //
+  // State of the current OpenGL context, use from the thread that owns it.
+  class StateCache
+  {
+  public:
+    struct Stats
+    {
+      uint64_t issued;  // GL calls made
+      uint64_t skipped; // redundant GL calls elided
+    };
+
+    static StateCache& getInstance();
+
+    // Forget the tracked state, the next calls are all issued
+    void invalidate();
+
+    void useProgram(GLuint program);
+
+    // Also forgets the element array buffer, which belongs to the vertex
+    //  array
+    void bindVertexArray(GLuint vertexArray);
+
+    // Tracks GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_PIXEL_PACK_BUFFER
+    //  and GL_PIXEL_UNPACK_BUFFER, other targets are always issued
+    void bindBuffer(GLenum target, GLuint buffer);
+
+    // GL_FRAMEBUFFER binds both the draw and the read framebuffers
+    void bindFramebuffer(GLenum target, GLuint framebuffer);
+
+    void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    // Current viewport: x, y, width, height. Queried once if unknown.
+    const std::array<GLint, 4>& getViewport();
+
+    void activeTexture(GLenum unit);
+
+    // Tracks GL_TEXTURE_2D on the first texture units, other targets and
+    //  units are always issued
+    void bindTexture(GLenum target, GLuint texture);
+
+    // The object was deleted, so it is no longer bound (and its name may be
+    //  reused)
+    void onDeleteProgram(GLuint program);
+    void onDeleteVertexArray(GLuint vertexArray);
+    void onDeleteBuffer(GLuint buffer);
+    void onDeleteFramebuffer(GLuint framebuffer);
+    void onDeleteTexture(GLuint texture);
+
+    const Stats& getStats() const { return stats_; }
+
+    void resetStats() { stats_ = {}; }
+
+  private:
+    // Name of a binding in an unknown state
+    static constexpr GLuint kUnknown{ ~0u };
+
+    static constexpr size_t kTextureUnits{ 16 };
+
+    enum BufferTarget
+    {
+      ArrayBuffer,
+      ElementArrayBuffer,
+      PixelPackBuffer,
+      PixelUnpackBuffer,
+      BufferTargets
+    };
+
+    GLuint program_;
+    GLuint vertexArray_;
+    std::array<GLuint, BufferTargets> buffers_;
+    GLuint drawFramebuffer_;
+    GLuint readFramebuffer_;
+    std::array<GLint, 4> viewport_;
+    bool viewportKnown_;
+    GLenum activeTexture_;
+    std::array<GLuint, kTextureUnits> textures2D_;
+    Stats stats_;
+
+    StateCache();
+
+    // Update `current` and count the call, returns false if redundant
+    bool change_(GLuint& current, GLuint value);
+  };
+} // namespace gl
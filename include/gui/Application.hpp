@@ -5,18 +5,47 @@
 
 #include <gui/Window.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <atomic>
+#include <functional>
+#include <thread>
 
 namespace gui
 {
+  // forward declaration
+  class TaskQueue;
+  class FramePacer;
+  class Recorder;
+
   class Application
   {
     static Application* instance_;
     std::unique_ptr<Window> window_;
     std::atomic<bool> running_;
+    std::atomic<int> redrawFrames_;
+    bool powerSaving_;
+    double maxIdleWait_;
+    std::atomic<bool> canWakeUp_;
+    std::atomic<int> wakeUpsInFlight_; // `requestRedraw()` calls using the window
+    std::unique_ptr<TaskQueue> tasks_;
+    std::atomic<std::thread::id> guiThreadId_;
+    std::unique_ptr<FramePacer> pacer_;
+    std::unique_ptr<Recorder> recorder_;
   public:
+    // Achieved frame intervals over the last few seconds
+    struct FrameStats
+    {
+      uint64_t frames;  // frames rendered since `run()`
+      double fps;       // average frame rate
+      double meanMs;
+      double minMs;
+      double p50Ms;
+      double p99Ms;
+      double maxMs;
+    };
+
     Application(
       const std::string& title = "Application",
       const Vec2i& windowSize = {640, 480});
@@ -30,6 +59,65 @@ namespace gui
 
     void run();
     void quit();
+
+    // Power saving mode
+    // -----------------
+    // When enabled, the main loop blocks while idle instead of rendering
+    // continuously. It is woken up by input events, by `requestRedraw()`, or
+    // after `maxWaitSeconds` at the latest (to keep timers, tooltips, etc.
+    // updating). A few frames are rendered after each wake up so that ImGui
+    // can settle.
+    void setPowerSaving(bool enable, double maxWaitSeconds = 1.0);
+    bool isPowerSaving() const { return powerSaving_; }
+
+    // Request new frames to be rendered. Thread-safe, it can be called from
+    //  timer callbacks or worker threads when the displayed data changes.
+    void requestRedraw();
+
+    // Run `task` on the GUI thread at the start of the next frame. Thread-safe
+    //  and lock-free up to the backend's wake-up call (e.g. an empty GLFW
+    //  event), it wakes up the main loop in power saving mode. Tasks still
+    //  queued when the application is destroyed are dropped.
+    void post(std::function<void()> task);
+
+    // Run `task` immediately if called from the GUI thread while the
+    //  application is running, otherwise `post()` it.
+    void dispatch(std::function<void()> task);
+
+    // Frame pacing
+    // ------------
+    // Caps the frame rate independently of vsync (e.g. 30 fps for background
+    // monitors, or uncapped with vsync off for latency-sensitive panels). The
+    // main loop sleeps, then spins, until the next frame deadline. Set `fps`
+    // to 0 for uncapped (default). Frames are still limited by vsync if it is
+    // enabled.
+    void setTargetFps(double fps);
+    double getTargetFps() const;
+
+    // Vsync mode of the window (default: On)
+    void setVsync(VsyncMode mode) { window_->setVsync(mode); }
+    VsyncMode getVsync() const { return window_->getVsync(); }
+
+    // Skip the render of frames whose draw data did not change (see
+    //  `Window::setSkipUnchangedFrames()`)
+    void setSkipUnchangedFrames(bool enable) { window_->setSkipUnchangedFrames(enable); }
+
+    // Force the next frame to be rendered and wake up the main loop, for
+    //  widgets whose content is not part of the ImGui draw data (e.g. OpenGL
+    //  frames). Thread-safe.
+    void invalidate();
+
+    // Achieved frame time statistics, call from the GUI thread
+    FrameStats getFrameStats() const;
+
+    // Screen recorder of the window (see `Recorder`), call from the GUI
+    //  thread. A recording still running when `run()` returns is stopped.
+    Recorder& getRecorder() { return *recorder_; }
+
+  private:
+    void runTasks_();
+    // Seconds to wait after a skipped frame: one frame period
+    double getSkippedFrameWait_() const;
   };
 
 } // namespace gui
@@ -0,0 +1,109 @@
+//  Copyright (c) 2024 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <imgui.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gui
+{
+  class Backend
+  {
+  public:
+    using Factory = std::function<std::unique_ptr<Backend>()>;
+    // Receives captured pixels, RGBA8 top row first, only valid during
+    //  the call
+    using CaptureCallback = std::function<void(const unsigned int* pixels_rgba, int w, int h)>;
+
+    virtual ~Backend() = default;
+
+    // Creates a backend by name
+    // -------------------------
+    // The backend is selected, in order, by:
+    //  1. `name`, if not empty
+    //  2. the `GUI_BACKEND` environment variable, if set (e.g. `GUI_BACKEND=null`)
+    //  3. the registered backend with the highest priority
+    // Throws `std::runtime_error` if the requested backend is not registered.
+    static std::unique_ptr<Backend> create(const std::string& name = {});
+
+    // Registers a backend factory, replacing any factory with the same name.
+    //  Built-in backends are "glfw_gl3" (priority 100, when compiled in),
+    //  "null" (priority 0) and "software" (priority -10).
+    static void registerFactory(
+      const std::string& name, Factory factory, int priority = 0);
+
+    // Names of the registered backends
+    static std::vector<std::string> getNames();
+
+    bool    DpiAware = true;                            // [In]  InitCreateWindow()
+    bool    SrgbFramebuffer = false;                    // [In]  InitCreateWindow()
+    ImVec4  ClearColor = { 0.f, 0.f, 0.f, 1.f };        // [In]  Render()
+    float   DpiScale = 1.0f;                            // [Out] InitCreateWindow() / NewFrame()
+    int     SwapInterval = 1;                           // [In]  Render(): 0 off, 1 vsync, -1 adaptive
+    bool    FramebufferLost = false;                    // [Out] NewFrame(): contents must be redrawn (e.g. window exposed)
+    float   RefreshRate = 60.0f;                        // [Out] InitCreateWindow(): display refresh rate in Hz
+
+    virtual bool InitCreateWindow(const char* window_title, ImVec2 window_size) = 0;
+    virtual void InitBackends() = 0;
+    virtual bool NewFrame() = 0;
+    virtual void Render() = 0;
+    // Block until an event arrives, `PostWakeup()` is called, or the timeout
+    //  (in seconds) expires
+    virtual void WaitEvents(double timeout) = 0;
+    // Wake up `WaitEvents()`, can be called from any thread
+    virtual void PostWakeup() = 0;
+    virtual void ShutdownCloseWindow() = 0;
+    virtual void ShutdownBackends() = 0;
+    virtual bool CaptureFramebuffer(
+      ImGuiViewport* viewport,
+      int x, int y, int w, int h,
+      unsigned int* pixels_rgba, void* user_data) = 0;
+    // Capture a region of the next rendered frame without stalling the
+    //  render loop. `callback` is called on the GUI thread from a later
+    //  `Render()` (usually the next one) when the pixels are available, and
+    //  is dropped if the backend shuts down first. Requests for the same
+    //  region before that `Render()` share one readback, each callback is
+    //  called. Returns false if the backend cannot capture.
+    virtual bool CaptureFramebufferAsync(
+      int x, int y, int w, int h, CaptureCallback callback)
+    {
+      IM_UNUSED(x); IM_UNUSED(y); IM_UNUSED(w); IM_UNUSED(h);
+      IM_UNUSED(callback);
+      return false;
+    }
+  };
+
+} // namespace gui
+
+// Registers a backend from a translation unit that is linked into the
+//  executable. `BackendClass` may be qualified (e.g. `my::Backend_Foo`).
+//
+// Usage:
+// ```cpp
+// class MyBackend : public gui::Backend { ... };
+//
+// REGISTER_BACKEND("my_backend", MyBackend, 10)
+// ```
+#define REGISTER_BACKEND(backendName, BackendClass, priority) \
+  REGISTER_BACKEND_IMPL_(backendName, BackendClass, priority, __COUNTER__)
+
+// The registration variable is named after a unique counter, so class
+//  names do not need to be identifiers
+#define REGISTER_BACKEND_IMPL_(backendName, BackendClass, priority, counter) \
+  REGISTER_BACKEND_VARIABLE_(backendName, BackendClass, priority, REGISTER_BACKEND_NAME_(counter))
+
+#define REGISTER_BACKEND_NAME_(counter) backendRegistration##counter##_
+
+#define REGISTER_BACKEND_VARIABLE_(backendName, BackendClass, priority, variable) \
+  namespace { \
+    static bool variable{ ( \
+      ::gui::Backend::registerFactory(backendName, \
+        []() -> std::unique_ptr<::gui::Backend> { \
+          return std::make_unique<BackendClass>(); }, \
+        priority), true) }; \
+  }
@@ -0,0 +1,73 @@
+//  Copyright (c) 2024 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <gui/Backend.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace gui
+{
+  class Backend_Null : public Backend
+  {
+  public:
+    ~Backend_Null() = default;
+
+    static std::unique_ptr<Backend_Null> create();
+
+    ImU64 LastTime = 0;
+    float Timeout = 1.0f;   // [In]  seconds until NewFrame() fails, 0 disables
+    float Elapsed = 0.0f;   // [Out] seconds since the first frame
+    ImU64 MaxFrames = 0;    // [In]  frames until NewFrame() fails, 0 disables
+    ImU64 FrameCount = 0;   // [Out] frames started
+
+    // Draw data statistics, computed by Render() when enabled
+    struct DrawListStats
+    {
+      const ImDrawList* List; // identifies the list across frames
+      int VtxCount;
+      int IdxCount;
+      int CmdCount;
+      uint64_t Hash;          // hash of vertices, indices and commands
+      bool Changed;           // hash differs from the previous frame, or new list
+    };
+
+    bool CollectDrawStats = false;        // [In]  Render(): count and hash the draw lists
+    std::vector<DrawListStats> DrawLists; // [Out] Render(): lists of the last frame
+    int DrawListsChanged = 0;             // [Out] Render(): changed lists in the last frame
+    ImU64 TotalDrawLists = 0;             // [Out] Render(): lists rendered since start
+    ImU64 TotalDrawListsChanged = 0;      // [Out] Render(): changed lists since start
+    ImU64 TotalVertices = 0;              // [Out] Render(): vertices rendered since start
+    ImU64 TotalIndices = 0;               // [Out] Render(): indices rendered since start
+
+    bool InitCreateWindow(const char* window_title, ImVec2 window_size) override;
+    void InitBackends() override;
+    bool NewFrame() override;
+    void Render() override;
+    void WaitEvents(double timeout) override;
+    void PostWakeup() override;
+    void ShutdownCloseWindow() override;
+    void ShutdownBackends() override;
+    bool CaptureFramebuffer(
+      ImGuiViewport* viewport,
+      int x, int y, int w, int h,
+      unsigned int* pixels_rgba, void* user_data) override;
+
+  private:
+    void collectDrawStats_(const ImDrawData* draw_data);
+
+    // Hashes of the previous frame, by draw list
+    std::unordered_map<const ImDrawList*, uint64_t> previousHashes_;
+    std::unordered_map<const ImDrawList*, uint64_t> currentHashes_;
+
+    std::mutex wakeupMutex_;
+    std::condition_variable wakeupCondition_;
+    bool wakeupPending_ = false;
+  };
+
+} // namespace gui
@@ -5,13 +5,18 @@
 
 #include <gui/Widget.hpp>
 
+#include <memory>
 #include <string>
 
 namespace gui
 {
+  // forward declaration
+  class Layout;
+
   class Frame : public Widget
   {
     int flags_;
+    std::unique_ptr<Layout> layout_;
   public:
     Frame(
       const std::string& name = {},
@@ -23,6 +28,11 @@ namespace gui
     bool renderBegin() override;
     void renderEnd() override;
     virtual void render() override;
+
+    // Attach a widget tree built once with `LayoutBuilder`. The layout fills
+    //  the frame content region and is drawn after `render()`.
+    void setLayout(std::unique_ptr<Layout> layout);
+    Layout* getLayout() const { return layout_.get(); }
   };
 
 } // namespace gui
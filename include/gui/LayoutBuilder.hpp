@@ -0,0 +1,89 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <gui/Widget.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace gui
+{
+  // forward declaration
+  class Sizer;
+  class StackingSizer;
+
+  // A widget tree built once by `LayoutBuilder`
+  // --------------------------------------------
+  // The layout owns the sizers created by the builder and any widget added
+  // with ownership transfer. Widgets added by pointer are only referenced and
+  // must outlive the layout.
+  class Layout
+  {
+    std::vector<std::unique_ptr<Widget>> widgets_;
+    Sizer* root_;
+    friend class LayoutBuilder;
+  public:
+    Layout();
+    ~Layout();
+
+    Layout(const Layout&) = delete;
+    Layout& operator=(const Layout&) = delete;
+
+    Sizer* getRoot() const { return root_; }
+
+    // Place the root sizer, the sizers only recompute their children when
+    //  the bounds change
+    void setBounds(const Vec2i& pos, const Vec2i& size);
+  };
+
+  // Declarative, build-once layout description
+  // ------------------------------------------
+  // Usage:
+  // ```cpp
+  // MainWindow()
+  // {
+  //   setLayout(gui::LayoutBuilder{}
+  //     .beginHorizontal()
+  //       .addFixed(&leftFrame_, 200)
+  //       .beginVertical(3)
+  //         .add(&topFrame_, 3)
+  //         .add(&bottomFrame_)
+  //       .end()
+  //     .end()
+  //     .build());
+  // }
+  // ```
+  class LayoutBuilder
+  {
+    std::unique_ptr<Layout> layout_;
+    std::vector<StackingSizer*> stack_;
+  public:
+    LayoutBuilder();
+    ~LayoutBuilder();
+
+    // Open a nested sizer (or the root sizer if none is open)
+    LayoutBuilder& beginVertical(int weight = 1);
+    LayoutBuilder& beginHorizontal(int weight = 1);
+
+    // Close the last opened sizer
+    LayoutBuilder& end();
+
+    // Add a widget to the current sizer, the widget is not owned
+    LayoutBuilder& add(Widget* child, int weight = 1);
+    LayoutBuilder& addFixed(Widget* child, int size);
+
+    // Add a widget to the current sizer, the layout takes ownership
+    LayoutBuilder& add(std::unique_ptr<Widget> child, int weight = 1);
+    LayoutBuilder& addFixed(std::unique_ptr<Widget> child, int size);
+
+    // Finish the description, all opened sizers must have been closed
+    std::unique_ptr<Layout> build();
+
+  private:
+    LayoutBuilder& begin_(std::unique_ptr<StackingSizer> sizer, int weight);
+    StackingSizer& current_(Widget* child);
+  };
+
+} // namespace gui
@@ -0,0 +1,148 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gui
+{
+  // Per-frame profiler
+  // ------------------
+  // Scoped zones are recorded into a fixed-size lock-free ring buffer (the
+  // oldest zones are overwritten). The application records zones around the
+  // stages of each frame and around each `Widget::draw`. Recorded zones can be
+  // shown in an overlay window or dumped as Chrome trace JSON (open it in
+  // chrome://tracing or https://ui.perfetto.dev).
+  //
+  // Zones are only recorded when the library is built with `USE_GUI_PROFILER`.
+  // Otherwise the `GUI_PROFILE_*` macros expand to nothing.
+  //
+  // Usage:
+  // ```cpp
+  // void MyFrame::render()
+  // {
+  //   GUI_PROFILE_SCOPE("MyFrame::updatePlot");
+  //   ...
+  // }
+  //
+  // gui::Profiler::getInstance().setOverlayVisible(true);
+  // ```
+  class Profiler
+  {
+  public:
+    // Maximum number of zones kept in the ring buffer
+    static constexpr size_t kCapacity{ 1U << 16 };
+
+    // Maximum length of a zone label (e.g. widget name), longer labels are
+    //  truncated
+    static constexpr size_t kLabelSize{ 32 };
+
+    struct Zone
+    {
+      const char* name;         // static string
+      char label[kLabelSize];   // optional, empty if none
+      uint64_t frame;
+      uint64_t beginNs;
+      uint64_t endNs;
+      uint32_t thread;
+      uint32_t depth;
+    };
+
+    // Records a zone from construction to destruction
+    class Scope
+    {
+      const char* name_;
+      const char* label_;
+      uint64_t frame_;
+      uint64_t beginNs_;
+    public:
+      explicit Scope(const char* name, const char* label = nullptr);
+      ~Scope();
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+    };
+
+    static Profiler& getInstance();
+
+    // Recording can be paused at runtime, enabled by default
+    void setEnabled(bool enable) { enabled_.store(enable, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Mark the start of a new frame
+    void beginFrame();
+    uint64_t getFrame() const { return frame_.load(std::memory_order_relaxed); }
+
+    // Monotonic time in nanoseconds
+    static uint64_t now();
+
+    // Record a finished zone, thread-safe and lock-free
+    void record(const char* name, const char* label,
+      uint64_t frame, uint64_t beginNs, uint64_t endNs, uint32_t depth);
+
+    // Get the zones still in the ring buffer, sorted by start time. Zones
+    //  that are being overwritten while reading are skipped.
+    std::vector<Zone> getZones() const;
+
+    // Get the zones of one frame, sorted by start time
+    std::vector<Zone> getZones(uint64_t frame) const;
+
+    // Write the zones in the ring buffer as Chrome trace JSON
+    void writeChromeTrace(std::ostream& os) const;
+    void writeChromeTrace(const std::string& filename) const;
+
+    // Overlay window with the zones of the last complete frame, drawn by the
+    //  application after the window contents
+    void setOverlayVisible(bool visible) { overlayVisible_ = visible; }
+    bool isOverlayVisible() const { return overlayVisible_; }
+    void drawOverlay();
+
+  private:
+    struct Slot
+    {
+      // Odd while the slot is being written
+      std::atomic<uint64_t> sequence{ 0 };
+      Zone zone{};
+    };
+
+    Profiler();
+
+    bool readSlot_(size_t index, Zone& zone) const;
+
+    std::atomic<bool> enabled_;
+    std::atomic<uint64_t> frame_;
+    // Thread that calls `beginFrame()`, its zones are recorded in frame order
+    std::atomic<uint32_t> frameThread_;
+    std::atomic<uint64_t> head_;
+    std::unique_ptr<Slot[]> slots_;
+    bool overlayVisible_;
+    std::vector<float> frameHistoryMs_;
+  };
+
+} // namespace gui
+
+#ifdef USE_GUI_PROFILER
+# define GUI_PROFILE_CONCAT_IMPL_(a, b) a##b
+# define GUI_PROFILE_CONCAT_(a, b) GUI_PROFILE_CONCAT_IMPL_(a, b)
+  // Record a zone until the end of the enclosing scope, `name` must be a
+  //  string literal
+# define GUI_PROFILE_SCOPE(name) \
+    ::gui::Profiler::Scope GUI_PROFILE_CONCAT_(guiProfileScope_, __LINE__){ name }
+  // Same as GUI_PROFILE_SCOPE, with a label copied into the zone (e.g. the
+  //  name of a widget)
+# define GUI_PROFILE_SCOPE_LABEL(name, label) \
+    ::gui::Profiler::Scope GUI_PROFILE_CONCAT_(guiProfileScope_, __LINE__){ name, label }
+# define GUI_PROFILE_FRAME() ::gui::Profiler::getInstance().beginFrame()
+# define GUI_PROFILE_OVERLAY() ::gui::Profiler::getInstance().drawOverlay()
+#else
+# define GUI_PROFILE_SCOPE(name) ((void)0)
+# define GUI_PROFILE_SCOPE_LABEL(name, label) ((void)0)
+# define GUI_PROFILE_FRAME() ((void)0)
+# define GUI_PROFILE_OVERLAY() ((void)0)
+#endif
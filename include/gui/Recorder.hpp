@@ -0,0 +1,138 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gui
+{
+  // forward declaration
+  class Backend;
+
+  // Screen recorder
+  // ---------------
+  // Captures every Nth rendered frame with the asynchronous capture of the
+  // backend and encodes it on a worker thread, so the render loop is not
+  // blocked. Captured frames are copied into a pool of reusable buffers and
+  // queued for the encoder. When the encoder falls behind and the queue is
+  // full, new frames are dropped and counted.
+  //
+  // The size of the recording is the size of the first captured frame,
+  // later frames of a different size are cropped or padded with black.
+  // Frames are only captured when they are rendered, so idle periods in
+  // power saving mode or skipped unchanged frames are not recorded.
+  //
+  // Usage:
+  // ```cpp
+  // gui::Recorder::Options options;
+  // options.format = gui::Recorder::Format::Pipe;
+  // options.output = "ffmpeg -y -f rawvideo -pix_fmt rgba -s {width}x{height}"
+  //   " -r {fps} -i - -pix_fmt yuv420p session.mp4";
+  // options.everyNthFrame = 2;
+  // options.fps = 30.0;
+  // app.getRecorder().start(options);
+  // ```
+  class Recorder
+  {
+  public:
+    enum class Format
+    {
+      Y4M,  // uncompressed YUV 4:2:0 stream in a single file
+      Png,  // one PNG per frame
+      Pipe, // raw RGBA frames written to the standard input of a command
+    };
+
+    struct Options
+    {
+      Format format = Format::Y4M;
+      // Y4M: output file.
+      // Png: file name, "{frame}" is replaced by the zero padded frame
+      //  number (e.g. "capture_{frame}.png").
+      // Pipe: command, "{width}", "{height}" and "{fps}" are replaced by the
+      //  size of the recording and `fps`.
+      std::string output;
+      int everyNthFrame = 1;  // capture one frame out of N rendered frames
+      double fps = 60.0;      // frame rate stored in the stream
+      size_t queueSize = 8;   // frames waiting for the encoder, others are dropped
+    };
+
+    struct Stats
+    {
+      uint64_t captured;  // frames delivered by the backend
+      uint64_t written;   // frames encoded
+      uint64_t dropped;   // frames lost because the queue was full or after an error
+      uint64_t bytes;     // bytes written
+    };
+
+    // Writes the frames to the output, defined in the implementation
+    class Encoder;
+
+    Recorder();
+    ~Recorder();
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    // Start recording, stopping any previous recording first. Throws
+    //  `std::invalid_argument` for invalid options and `std::runtime_error`
+    //  if the output file cannot be created.
+    void start(const Options& options);
+
+    // Encode the queued frames and close the output
+    void stop();
+
+    bool isRecording() const { return recording_; }
+
+    Stats getStats() const;
+
+    // Last encoder error, empty if none. The encoder stops writing after
+    //  an error.
+    std::string getError() const;
+
+    // Called by the application after each rendered frame (GUI thread)
+    void onFrame(Backend& backend);
+
+  private:
+    struct Frame
+    {
+      std::vector<uint32_t> pixels; // RGBA8, top row first
+      uint64_t index;
+    };
+
+    void capture_(const unsigned int* pixels, int w, int h);
+    void run_();
+
+    Options options_;
+    bool recording_;
+    uint64_t frameCounter_;
+    // Captures requested by a previous recording are ignored
+    std::shared_ptr<int> session_;
+    int width_;
+    int height_;
+
+    // Shared with the encoder thread
+    mutable std::mutex mutex_;
+    std::condition_variable queueChanged_;
+    std::deque<Frame> queue_;
+    std::vector<std::vector<uint32_t>> pool_;
+    bool stopping_;
+    std::string error_;
+    std::unique_ptr<Encoder> encoder_;
+    std::thread thread_;
+
+    std::atomic<uint64_t> captured_;
+    std::atomic<uint64_t> written_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> bytes_;
+  };
+
+} // namespace gui
@@ -14,17 +14,36 @@ namespace gui
 
     StackingSizer(Direction direction);
 
-    void addChild(Widget* child, int weight = 1);
+    void addChild(Widget* child) override;
+
+    void addChild(Widget* child, int weight);
 
     void addWithFixedSize(Widget* child, int size);
 
+    void removeChild(Widget* child) override;
+
+    // Change the weight of an existing child (negative for fixed size)
+    void setWeight(Widget* child, int weight);
+
+    // Force the layout to be recomputed on the next `apply()`
+    void invalidate() { layoutDirty_ = true; }
+
     void draw() override;
 
+    // Updates size and position of the children. The computed layout is
+    // retained and only recomputed when the sizer position, size, item
+    // spacing, child list, or child weights change.
     void apply();
 
   private:
     Direction direction_;
     std::vector<int> weights_;
+
+    // Layout cache
+    bool layoutDirty_;
+    Vec2i layoutPos_;
+    Vec2i layoutSize_;
+    Vec2i layoutSpacing_;
   };
 
 } // namespace gui
@@ -9,4 +9,7 @@ namespace gui
 {
   using math::Vec2i;
 
+  // Widget identifier, same type as `ImGuiID`
+  using WidgetId = unsigned int;
+
 } // namespace gui
@@ -5,6 +5,7 @@
 
 #include <gui/Rect.hpp>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -12,7 +13,9 @@ namespace gui
 {
   class Widget : public Rect
   {
-    std::string name_;
+    mutable std::string name_;  // formatted on first use for generated names
+    uint64_t serial_;           // 0 if the name was given by the user
+    WidgetId id_;
     std::vector<Widget*> children_;
   public:
     Widget(
@@ -30,6 +33,9 @@ namespace gui
 
     void setName(const std::string& name);
 
+    // ImGui identifier, computed once at construction or in `setName`
+    WidgetId getId() const { return id_; }
+
     const std::vector<Widget*>& getChildren() const;
 
     virtual void addChild(Widget* child);
@@ -5,6 +5,8 @@
 
 #include <gui/Types.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -16,6 +18,15 @@ namespace gui
   class Sizer;
   class Backend;
 
+  // Synchronization of buffer swaps with the display refresh
+  enum class VsyncMode
+  {
+    Off,      // swap immediately, may tear
+    On,       // wait for the vertical blank
+    Adaptive, // wait for the vertical blank, unless the frame is late (if
+              //  supported by the driver, otherwise same as On)
+  };
+
   // A top-level window
   // ------------------
   // The window instance will register itself with the global application
@@ -29,6 +40,12 @@ namespace gui
     std::vector<Frame*> frames_;
     std::unique_ptr<Sizer> sizer_;
     std::unique_ptr<Backend> backend_;
+    std::string backendName_;
+    VsyncMode vsync_;
+    bool skipUnchangedFrames_;
+    uint64_t lastDrawDataHash_;
+    std::atomic<bool> invalidated_;
+    uint64_t skippedFrames_;
   public:
     Window(
       const std::string& title = "Window",
@@ -42,14 +59,55 @@ namespace gui
     void setTitle(const std::string& title) { title_ = title; }
 
     bool renderBegin();
-    void renderEnd();
+    // Returns false if the frame was skipped (see `setSkipUnchangedFrames()`)
+    bool renderEnd();
     virtual void render();
 
+    // Block until an input event arrives, `wakeUp()` is called, or the
+    //  timeout (in seconds) expires
+    void waitEvents(double timeout);
+
+    // Wake up `waitEvents()`, can be called from any thread while the window
+    //  is initialized
+    void wakeUp();
+
+    // Vsync mode, can be changed at any time (default: On)
+    void setVsync(VsyncMode mode);
+    VsyncMode getVsync() const { return vsync_; }
+
+    // Skip unchanged frames
+    // ---------------------
+    // When enabled, the draw data of each frame is hashed and, if it is
+    // equal to the previous frame, the backend render and buffer swap are
+    // skipped, so the last image stays on screen. The main loop then waits
+    // for input for up to one frame period instead of spinning, since there
+    // is no buffer swap to block on vsync. Content drawn by render
+    // callbacks or into textures (e.g. OpenGL frames) is not part of the
+    // hash: call `invalidate()` when it changes.
+    void setSkipUnchangedFrames(bool enable) { skipUnchangedFrames_ = enable; }
+    bool getSkipUnchangedFrames() const { return skipUnchangedFrames_; }
+
+    // Force the next frame to be rendered, can be called from any thread
+    void invalidate() { invalidated_.store(true); }
+
+    // Number of frames whose render was skipped
+    uint64_t getSkippedFrameCount() const { return skippedFrames_; }
+
     void addFrame(Frame* frame);
     void removeFrame(Frame* frame);
     std::vector<Frame*>& getFrames();
 
     Backend* getBackendPtr() { return backend_.get(); }
+
+    // Use the given backend instead of the default one, must be called
+    //  before `init()`
+    void setBackend(std::unique_ptr<Backend> backend);
+
+    // Select a registered backend by name (e.g. "null", "software", "glfw_gl3"), must be
+    //  called before `init()`. If empty, the `GUI_BACKEND` environment
+    //  variable or the default backend is used.
+    void setBackendName(const std::string& name) { backendName_ = name; }
+    const std::string& getBackendName() const { return backendName_; }
   };
 
 } // namespace gui
@@ -9,9 +9,13 @@
 #include <gui/Sizer.hpp>
 #include <gui/VerticalSizer.hpp>
 #include <gui/HorizontalSizer.hpp>
+#include <gui/LayoutBuilder.hpp>
 #include <gui/Frame.hpp>
 #include <gui/ChildFrame.hpp>
 #include <gui/Application.hpp>
+#include <gui/Backend.hpp>
+#include <gui/Profiler.hpp>
+#include <gui/Recorder.hpp>
 
 #include <gui/imgui_stdlib.hpp>
 
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <functional>
 
@@ -16,19 +18,85 @@ namespace timer
     // Callback type
     using Callback = std::function<void()>;
 
+    // Executor type, runs a callback somewhere else (e.g. posts it to the
+    //  GUI thread)
+    using Executor = std::function<void(Callback)>;
+
+    // What to do when a callback runs so late that the next deadline has
+    //  already passed
+    enum class OverrunPolicy
+    {
+      Skip,     // drop the missed ticks and stay on the original phase
+      CatchUp,  // run the missed ticks back to back
+      Coalesce, // run one tick and restart the period from it
+    };
+
+    // Scheduling statistics since the last `start()`
+    struct Stats
+    {
+      uint64_t ticks;                       // callbacks run
+      uint64_t missedDeadlines;             // ticks skipped or run a period late
+      std::chrono::nanoseconds maxJitter;   // largest callback delay
+      std::chrono::nanoseconds meanJitter;  // average callback delay
+    };
+
     // Default constructor
     Timer();
 
     // Destructor
     ~Timer();
 
-    // Start the timer
+    // Start the timer. A running timer is rearmed in place: the new period
+    //  and callback apply from now on.
     void start(size_t milliseconds, Callback callback);
 
-    // Stop the timer
+    // Start the timer with a sub-millisecond period. Deadlines are absolute
+    //  (each one is a period after the previous one), so the timer does not
+    //  drift with the callback duration or the wakeup latency.
+    void start(std::chrono::microseconds period, Callback callback);
+
+    // Call `callback` once after `delay`. Calling it again before the timer
+    //  fires rearms the delay.
+    void startOnce(std::chrono::microseconds delay, Callback callback);
+
+    // Debounce: call `callback` once, `delay` after the last call to
+    //  `debounce()` (e.g. apply a filter once the user stops typing)
+    void debounce(std::chrono::microseconds delay, Callback callback);
+
+    // Max rate: call the latest `callback` at most once per `interval`. The
+    //  first call runs right away, calls within the interval are coalesced
+    //  into one call at the end of it.
+    void throttle(std::chrono::microseconds interval, Callback callback);
+
+    // Stop the timer. If the callback is running, waits for it to complete
+    //  (unless called from the callback itself).
     void stop();
 
-    // Check if the timer is running
+    // Stop the timer without waiting for a running callback
+    void cancel();
+
+    // Check if the timer is running. One-shot, debounce and throttle timers
+    //  stop running when their callback is called.
     bool isRunning() const;
+
+    // Set the overrun policy used by the next `start()` (default: Skip)
+    void setOverrunPolicy(OverrunPolicy policy);
+
+    // Get the scheduling statistics
+    Stats getStats() const;
+
+    // Deliver the callbacks through `executor` instead of calling them on
+    //  the timer thread. Applies from the next `start()`. Callbacks that were
+    //  handed to the executor are not called if the timer was stopped (or
+    //  restarted) in the meantime.
+    //
+    // Usage:
+    // ```cpp
+    // timer.setExecutor([](timer::Timer::Callback callback)
+    //   {
+    //     gui::Application::getInstancePtr()->post(std::move(callback));
+    //   });
+    // ```
+    void setExecutor(Executor executor);
   };
 } // namespace timer
@@ -2,6 +2,8 @@
 //
 
 #include <gl/Circle.hpp>
+#include <gl/ProgramCache.hpp>
+#include <gl/StateCache.hpp>
 
 #include <stdexcept>
 #include <cmath>
@@ -12,6 +14,9 @@ namespace gl
 {
   Circle::Circle(size_t numSegments) :
     program_{ nullptr },
+    uCenter_{},
+    uRadius_{},
+    uColor_{},
     VBO{ 0 },
     VAO{ 0 },
     initialized_{ false },
@@ -86,27 +91,32 @@ namespace gl
       {
         throw std::runtime_error("Unsupported GLSL version");
       }
-      program_ = std::make_unique<gl::Program>(vertexShader, fragmentShader);
+      program_ = ProgramCache::getInstance().get(vertexShader, fragmentShader);
+      uCenter_ = program_->getUniform<std::array<float, 3>>("uCenter");
+      uRadius_ = program_->getUniform<float>("uRadius");
+      uColor_ = program_->getUniform<std::array<float, 4>>("uColor");
     }
 
+    StateCache& state{ StateCache::getInstance() };
+
     // Configure the vertex buffer object (VBO)
     glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    state.bindBuffer(GL_ARRAY_BUFFER, VBO);
     const std::vector<float> vertices{ generateVertices_() };
     glBufferData(GL_ARRAY_BUFFER,
       sizeof(float)*vertices.size(), vertices.data(), GL_STATIC_DRAW);
 
     // Configure the vertex array object (VAO)
     glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
+    state.bindVertexArray(VAO);
 
     // Position attribute
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0);
     glEnableVertexAttribArray(0);
 
     // Clean up
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    state.bindBuffer(GL_ARRAY_BUFFER, 0);
+    state.bindVertexArray(0);
 
     // Set the initialized flag
     initialized_ = true;
@@ -118,6 +128,9 @@ namespace gl
     {
       glDeleteVertexArrays(1, &VAO);
       glDeleteBuffers(1, &VBO);
+      StateCache::getInstance().onDeleteVertexArray(VAO);
+      StateCache::getInstance().onDeleteBuffer(VBO);
+      initialized_ = false;
     }
   }
 
@@ -128,33 +141,37 @@ namespace gl
       throw std::runtime_error("Circle not initialized");
     }
 
-    // Bind the VAO
-    glBindVertexArray(VAO);
-
-    // Bind the VBO
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
     // Use the shader program
     program_->use();
 
-    // Set the uniforms
-    program_->setUniform3f("uCenter", center_);
-    program_->setUniform1f("uRadius", radius_);
-    program_->setUniform4f("uColor", color_);
-
-    // Draw the vertices
-    glDrawArrays(GL_TRIANGLE_FAN, 0, numSegments_ + 1);
-
-    // Unbind the VBO
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    drawBatchedGL();
 
     // Unbind the VAO
-    glBindVertexArray(0);
+    StateCache::getInstance().bindVertexArray(0);
 
     // Unuse the shader program
     program_->unuse();
   }
 
+  void Circle::drawBatchedGL() const
+  {
+    if (!initialized_)
+    {
+      throw std::runtime_error("Circle not initialized");
+    }
+
+    // Bind the VAO
+    StateCache::getInstance().bindVertexArray(VAO);
+
+    // Set the uniforms
+    uCenter_.set(center_);
+    uRadius_.set(radius_);
+    uColor_.set(color_);
+
+    // Draw the vertices
+    glDrawArrays(GL_TRIANGLE_FAN, 0, numSegments_ + 1);
+  }
+
   void Circle::setColor(float r, float g, float b, float a)
   {
     color_[0] = r;
@@ -0,0 +1,382 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include <gl/CircleBatch.hpp>
+#include <gl/Extensions.hpp>
+#include <gl/ProgramCache.hpp>
+#include <gl/StateCache.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+constexpr static double PI{ 3.14159265358979323846 };
+
+namespace gl
+{
+  CircleBatch::CircleBatch(size_t numSegments) :
+    program_{ nullptr },
+    VBO{ 0 },
+    VAO{ 0 },
+    instanceVBO_{ 0 },
+    centerLocation_{ -1 },
+    radiusLocation_{ -1 },
+    colorLocation_{ -1 },
+    initialized_{ false },
+    numSegments_{ numSegments },
+    centers_{},
+    radii_{},
+    colors_{},
+    dirty_{ true },
+    capacity_{ 0 },
+    uploadedBytes_{ 0 }
+  {
+
+  }
+
+  CircleBatch::~CircleBatch()
+  {
+    deinitGL();
+  }
+
+  void CircleBatch::initGL()
+  {
+    if (initialized_)
+    { // Already initialized
+      return;
+    }
+
+    if (!program_)
+    {
+      const size_t glslVersion{ gl::Shader::getShadingLanguageVersion() };
+      std::string vertexShader, fragmentShader;
+      if (glslVersion == 140)
+      {
+        vertexShader =
+          "#version 140\n"
+          "attribute vec2 aPos;\n"
+          "attribute vec3 aCenter;\n"
+          "attribute float aRadius;\n"
+          "attribute vec4 aColor;\n"
+          "varying vec4 vColor;\n"
+          "void main()\n"
+          "{\n"
+          "  vColor = aColor;\n"
+          "  gl_Position = vec4(vec3(aPos * aRadius, 0.0) + aCenter, 1.0);\n"
+          "}\n"
+          ;
+        fragmentShader =
+          "#version 140\n"
+          "varying vec4 vColor;\n"
+          "void main()\n"
+          "{\n"
+          "  gl_FragColor = vColor;\n"
+          "}\n"
+          ;
+      }
+      else if (glslVersion > 140)
+      {
+        vertexShader =
+          "#version 150\n"
+          "in vec2 aPos;\n"
+          "in vec3 aCenter;\n"
+          "in float aRadius;\n"
+          "in vec4 aColor;\n"
+          "out vec4 vColor;\n"
+          "void main()\n"
+          "{\n"
+          "  vColor = aColor;\n"
+          "  gl_Position = vec4(vec3(aPos * aRadius, 0.0) + aCenter, 1.0);\n"
+          "}\n"
+          ;
+        fragmentShader =
+          "#version 150\n"
+          "in vec4 vColor;\n"
+          "out vec4 FragColor;\n"
+          "void main()\n"
+          "{\n"
+          "  FragColor = vColor;\n"
+          "}\n"
+          ;
+      }
+      else
+      {
+        throw std::runtime_error("Unsupported GLSL version");
+      }
+      // The per-vertex position must be attribute 0 (it drives the vertex
+      //  fetch in compatibility profiles), bind the locations before linking
+      program_ = ProgramCache::getInstance().get(vertexShader, fragmentShader,
+        { { "aPos", 0 }, { "aCenter", 1 }, { "aRadius", 2 }, { "aColor", 3 } });
+      centerLocation_ = glGetAttribLocation(program_->get(), "aCenter");
+      radiusLocation_ = glGetAttribLocation(program_->get(), "aRadius");
+      colorLocation_ = glGetAttribLocation(program_->get(), "aColor");
+    }
+
+    StateCache& state{ StateCache::getInstance() };
+
+    // Configure the vertex buffer object (VBO)
+    glGenBuffers(1, &VBO);
+    state.bindBuffer(GL_ARRAY_BUFFER, VBO);
+    const std::vector<float> vertices{ generateVertices_() };
+    glBufferData(GL_ARRAY_BUFFER,
+      sizeof(float)*vertices.size(), vertices.data(), GL_STATIC_DRAW);
+
+    // Configure the vertex array object (VAO)
+    glGenVertexArrays(1, &VAO);
+    state.bindVertexArray(VAO);
+
+    // Position attribute
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0);
+    glEnableVertexAttribArray(0);
+
+    // Per-instance attributes, the pointers are set by `upload_()`
+    glGenBuffers(1, &instanceVBO_);
+    const Extensions& ext{ Extensions::get() };
+    if (ext.hasInstancedArrays())
+    {
+      for (const GLint location : { centerLocation_, radiusLocation_, colorLocation_ })
+      {
+        if (location >= 0)
+        {
+          glEnableVertexAttribArray(static_cast<GLuint>(location));
+          ext.VertexAttribDivisor(static_cast<GLuint>(location), 1);
+        }
+      }
+    }
+
+    // Clean up
+    state.bindBuffer(GL_ARRAY_BUFFER, 0);
+    state.bindVertexArray(0);
+
+    // Set the initialized flag
+    capacity_ = 0;
+    uploadedBytes_ = 0;
+    dirty_ = true;
+    initialized_ = true;
+  }
+
+  void CircleBatch::deinitGL()
+  {
+    if (initialized_)
+    {
+      glDeleteVertexArrays(1, &VAO);
+      glDeleteBuffers(1, &VBO);
+      glDeleteBuffers(1, &instanceVBO_);
+      StateCache& state{ StateCache::getInstance() };
+      state.onDeleteVertexArray(VAO);
+      state.onDeleteBuffer(VBO);
+      state.onDeleteBuffer(instanceVBO_);
+      initialized_ = false;
+    }
+  }
+
+  void CircleBatch::upload_() const
+  {
+    // Structure of arrays in one buffer: centers, radii, colors
+    const size_t count{ size() };
+    const size_t centersSize{ sizeof(float) * centers_.size() };
+    const size_t radiiSize{ sizeof(float) * radii_.size() };
+    const size_t colorsSize{ sizeof(float) * colors_.size() };
+
+    StateCache::getInstance().bindBuffer(GL_ARRAY_BUFFER, instanceVBO_);
+    if (count > capacity_)
+    { // grow geometrically, so adding circles does not reallocate every frame
+      capacity_ = std::max(count, 2 * capacity_);
+    }
+    // Orphan the previous storage: the driver hands out a new one instead
+    //  of waiting for the draws still reading the old one
+    glBufferData(GL_ARRAY_BUFFER,
+      static_cast<GLsizeiptr>(capacity_ * 8 * sizeof(float)), nullptr, GL_STREAM_DRAW);
+    const size_t radiiOffset{ capacity_ * 3 * sizeof(float) };
+    const size_t colorsOffset{ capacity_ * 4 * sizeof(float) };
+    glBufferSubData(GL_ARRAY_BUFFER, 0,
+      static_cast<GLsizeiptr>(centersSize), centers_.data());
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(radiiOffset),
+      static_cast<GLsizeiptr>(radiiSize), radii_.data());
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(colorsOffset),
+      static_cast<GLsizeiptr>(colorsSize), colors_.data());
+    uploadedBytes_ += centersSize + radiiSize + colorsSize;
+
+    // The offsets depend on the capacity, set the pointers (VAO must be bound)
+    if (centerLocation_ >= 0)
+    {
+      glVertexAttribPointer(static_cast<GLuint>(centerLocation_), 3, GL_FLOAT, GL_FALSE,
+        3 * sizeof(float), 0);
+    }
+    if (radiusLocation_ >= 0)
+    {
+      glVertexAttribPointer(static_cast<GLuint>(radiusLocation_), 1, GL_FLOAT, GL_FALSE,
+        sizeof(float), reinterpret_cast<const void*>(radiiOffset));
+    }
+    if (colorLocation_ >= 0)
+    {
+      glVertexAttribPointer(static_cast<GLuint>(colorLocation_), 4, GL_FLOAT, GL_FALSE,
+        4 * sizeof(float), reinterpret_cast<const void*>(colorsOffset));
+    }
+    dirty_ = false;
+  }
+
+  void CircleBatch::drawGL() const
+  {
+    if (!initialized_)
+    {
+      throw std::runtime_error("CircleBatch not initialized");
+    }
+    if (radii_.empty())
+    {
+      return;
+    }
+
+    // Use the shader program
+    program_->use();
+
+    drawBatchedGL();
+
+    // Unbind the VBO and the VAO
+    StateCache& state{ StateCache::getInstance() };
+    state.bindBuffer(GL_ARRAY_BUFFER, 0);
+    state.bindVertexArray(0);
+
+    // Unuse the shader program
+    program_->unuse();
+  }
+
+  void CircleBatch::drawBatchedGL() const
+  {
+    if (!initialized_)
+    {
+      throw std::runtime_error("CircleBatch not initialized");
+    }
+    if (radii_.empty())
+    {
+      return;
+    }
+
+    // Bind the VAO
+    StateCache::getInstance().bindVertexArray(VAO);
+
+    const GLsizei numVertices{ static_cast<GLsizei>(numSegments_ + 1) };
+    const Extensions& ext{ Extensions::get() };
+    if (ext.hasInstancedArrays())
+    {
+      if (dirty_)
+      {
+        upload_();
+      }
+
+      // Draw all the circles
+      glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, numVertices, static_cast<GLsizei>(size()));
+    }
+    else
+    {
+      // No per-instance attributes: the arrays are disabled, so the
+      //  attributes take the current values set for each circle
+      for (size_t i = 0; i < size(); ++i)
+      {
+        if (centerLocation_ >= 0)
+        {
+          glVertexAttrib3fv(static_cast<GLuint>(centerLocation_), &centers_[3 * i]);
+        }
+        if (radiusLocation_ >= 0)
+        {
+          glVertexAttrib1f(static_cast<GLuint>(radiusLocation_), radii_[i]);
+        }
+        if (colorLocation_ >= 0)
+        {
+          glVertexAttrib4fv(static_cast<GLuint>(colorLocation_), &colors_[4 * i]);
+        }
+        glDrawArrays(GL_TRIANGLE_FAN, 0, numVertices);
+      }
+    }
+  }
+
+  size_t CircleBatch::getDrawCallCount() const
+  {
+    if (radii_.empty())
+    {
+      return 0;
+    }
+    return Extensions::get().hasInstancedArrays() ? 1 : size();
+  }
+
+  size_t CircleBatch::add(
+    const std::array<float, 3>& center, float radius,
+    const std::array<float, 4>& color)
+  {
+    centers_.insert(centers_.end(), center.begin(), center.end());
+    radii_.push_back(radius);
+    colors_.insert(colors_.end(), color.begin(), color.end());
+    dirty_ = true;
+    return radii_.size() - 1;
+  }
+
+  void CircleBatch::resize(size_t count)
+  {
+    const size_t previous{ size() };
+    centers_.resize(3 * count, 0.0f);
+    radii_.resize(count, 1.0f);
+    colors_.resize(4 * count, 0.0f);
+    for (size_t i = previous; i < count; ++i)
+    {
+      colors_[4 * i] = 1.0f;
+      colors_[4 * i + 3] = 1.0f;
+    }
+    dirty_ = true;
+  }
+
+  void CircleBatch::reserve(size_t count)
+  {
+    centers_.reserve(3 * count);
+    radii_.reserve(count);
+    colors_.reserve(4 * count);
+  }
+
+  void CircleBatch::clear()
+  {
+    centers_.clear();
+    radii_.clear();
+    colors_.clear();
+    dirty_ = true;
+  }
+
+  void CircleBatch::setColor(size_t index, float r, float g, float b, float a)
+  {
+    colors_[4 * index] = r;
+    colors_[4 * index + 1] = g;
+    colors_[4 * index + 2] = b;
+    colors_[4 * index + 3] = a;
+    dirty_ = true;
+  }
+
+  void CircleBatch::setRadius(size_t index, float radius)
+  {
+    radii_[index] = radius;
+    dirty_ = true;
+  }
+
+  void CircleBatch::setCenter(size_t index, float x, float y, float z)
+  {
+    centers_[3 * index] = x;
+    centers_[3 * index + 1] = y;
+    centers_[3 * index + 2] = z;
+    dirty_ = true;
+  }
+
+  std::vector<float> CircleBatch::generateVertices_() const
+  {
+    // Same fan as `Circle`
+    const double angleStep{ 2 * PI / (numSegments_ - 1) };
+    std::vector<float> vertices;
+    vertices.reserve(2 + numSegments_ * 2);
+    vertices.emplace_back(0.0f);
+    vertices.emplace_back(0.0f);
+    for (size_t i = 0; i < numSegments_; ++i)
+    {
+      const double angle{ i * angleStep };
+      vertices.emplace_back(static_cast<float>(std::cos(angle)));
+      vertices.emplace_back(static_cast<float>(std::sin(angle)));
+    }
+    return vertices;
+  }
+
+} // namespace gl
@@ -0,0 +1,143 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include <gl/Extensions.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+#ifndef GL_NUM_EXTENSIONS
+# define GL_NUM_EXTENSIONS 0x821D
+#endif
+#ifndef GL_MAJOR_VERSION
+# define GL_MAJOR_VERSION 0x821B
+# define GL_MINOR_VERSION 0x821C
+#endif
+
+namespace gl
+{
+  namespace
+  {
+    Extensions extensions_;
+
+    // Indexed extension names (OpenGL 3.0), the only way to query them on
+    //  core profiles
+    using GetStringi = const GLubyte* (GL_EXTENSIONS_APIENTRY_*)(GLenum name, GLuint index);
+
+    int version_()
+    {
+      GLint major{ 0 };
+      GLint minor{ 0 };
+      glGetIntegerv(GL_MAJOR_VERSION, &major);
+      glGetIntegerv(GL_MINOR_VERSION, &minor);
+      if (major >= 3)
+      {
+        return major * 10 + minor;
+      }
+
+      // GL_MAJOR_VERSION needs OpenGL 3.0, parse the version string instead
+      //  ("<major>.<minor>[.<release>] [vendor info]")
+      const char* version{ reinterpret_cast<const char*>(glGetString(GL_VERSION)) };
+      if (version == nullptr)
+      {
+        return 0;
+      }
+      while (*version && (*version < '0' || *version > '9'))
+      { // OpenGL ES prefix
+        ++version;
+      }
+      char* end{ nullptr };
+      major = static_cast<GLint>(std::strtol(version, &end, 10));
+      minor = (end && *end == '.') ? static_cast<GLint>(std::strtol(end + 1, nullptr, 10)) : 0;
+      return major * 10 + minor;
+    }
+
+    bool hasExtension_(const char* name, GetStringi getStringi, GLint count)
+    {
+      if (getStringi != nullptr)
+      {
+        for (GLint i = 0; i < count; ++i)
+        {
+          const char* extension{ reinterpret_cast<const char*>(getStringi(GL_EXTENSIONS, static_cast<GLuint>(i))) };
+          if (extension != nullptr && std::strcmp(extension, name) == 0)
+          {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      const char* all{ reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS)) };
+      if (all == nullptr)
+      {
+        return false;
+      }
+      const size_t length{ std::strlen(name) };
+      for (const char* found = std::strstr(all, name); found; found = std::strstr(found + length, name))
+      {
+        const bool start{ found == all || found[-1] == ' ' };
+        const bool end{ found[length] == ' ' || found[length] == '\0' };
+        if (start && end)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    template <typename T>
+    void loadProc_(T& proc, Extensions::GetProcAddress getProcAddress, const char* name)
+    {
+      proc = reinterpret_cast<T>(getProcAddress(name));
+    }
+  } // namespace
+
+  void Extensions::load(GetProcAddress getProcAddress)
+  {
+    extensions_ = Extensions{};
+    glGetError(); // clear, the version queries are invalid before OpenGL 3.0
+
+    // The loader may return non-null pointers for unsupported functions, so
+    //  check the version or the extension first
+    const int version{ version_() };
+    GetStringi getStringi{ nullptr };
+    GLint count{ 0 };
+    if (version >= 30)
+    { // the extension string was removed from core profiles
+      loadProc_(getStringi, getProcAddress, "glGetStringi");
+      glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    }
+    if (version >= 32 || hasExtension_("GL_ARB_sync", getStringi, count))
+    {
+      loadProc_(extensions_.FenceSync, getProcAddress, "glFenceSync");
+      loadProc_(extensions_.ClientWaitSync, getProcAddress, "glClientWaitSync");
+      loadProc_(extensions_.DeleteSync, getProcAddress, "glDeleteSync");
+    }
+    if (version >= 33)
+    {
+      loadProc_(extensions_.VertexAttribDivisor, getProcAddress, "glVertexAttribDivisor");
+    }
+    else if (hasExtension_("GL_ARB_instanced_arrays", getStringi, count))
+    {
+      loadProc_(extensions_.VertexAttribDivisor, getProcAddress, "glVertexAttribDivisorARB");
+    }
+    if (version >= 41 || hasExtension_("GL_ARB_get_program_binary", getStringi, count))
+    {
+      GLint formats{ 0 };
+      glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+      if (formats > 0)
+      {
+        loadProc_(extensions_.GetProgramBinary, getProcAddress, "glGetProgramBinary");
+        loadProc_(extensions_.ProgramBinary, getProcAddress, "glProgramBinary");
+        loadProc_(extensions_.ProgramParameteri, getProcAddress, "glProgramParameteri");
+      }
+    }
+    glGetError();
+  }
+
+  const Extensions& Extensions::get()
+  {
+    return extensions_;
+  }
+
+} // namespace gl
@@ -3,6 +3,7 @@
 
 #include <gl/gl.h>
 #include <gl/FrameBuffer.hpp>
+#include <gl/StateCache.hpp>
 
 #include <stdexcept>
 
@@ -30,6 +31,9 @@ namespace gl
     glDeleteFramebuffers(1, &fbo_);
     glDeleteTextures(1, &texture_);
     glDeleteRenderbuffers(1, &rbo_);
+    StateCache& state{ StateCache::getInstance() };
+    state.onDeleteFramebuffer(fbo_);
+    state.onDeleteTexture(texture_);
   }
 
   void FrameBuffer::setSize(const Vec2i& size)
@@ -43,12 +47,12 @@ namespace gl
 
   void FrameBuffer::bind() const
   {
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    StateCache::getInstance().bindFramebuffer(GL_FRAMEBUFFER, fbo_);
   }
 
   void FrameBuffer::unbind() const
   {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    StateCache::getInstance().bindFramebuffer(GL_FRAMEBUFFER, 0);
   }
 
   void FrameBuffer::generateFrameBuffer_()
@@ -57,7 +61,8 @@ namespace gl
     bind();
 
     // Create a color attachment texture
-    glBindTexture(GL_TEXTURE_2D, texture_);
+    StateCache& state{ StateCache::getInstance() };
+    state.bindTexture(GL_TEXTURE_2D, texture_);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, size_.x, size_.y, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -73,7 +78,7 @@ namespace gl
 
     // Unbind everything
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    state.bindTexture(GL_TEXTURE_2D, 0);
     unbind();
 
     // Check if the frame buffer is complete
@@ -3,12 +3,29 @@
 
 #include <gl/gl.h>
 #include <gl/Program.hpp>
+#include <gl/Extensions.hpp>
+#include <gl/StateCache.hpp>
 
+#include <cstring>
 #include <vector>
 #include <stdexcept>
 
 namespace gl
 {
+  namespace
+  {
+    // FNV-1a
+    uint32_t hashName_(const char* name)
+    {
+      uint32_t hash{ 2166136261U };
+      for (; *name; ++name)
+      {
+        hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619U;
+      }
+      return hash;
+    }
+  } // namespace
+
   Program::Program()
   {
     program_ = glCreateProgram();
@@ -17,18 +34,24 @@ namespace gl
   Program::~Program()
   {
     glDeleteProgram(program_);
+    StateCache::getInstance().onDeleteProgram(program_);
   }
 
   Program::Program(const std::string& vertexShader, const std::string& fragmentShader)
   {
     program_ = glCreateProgram();
+    attachShaders(vertexShader, fragmentShader);
+    link();
+  }
+
+  void Program::attachShaders(const std::string& vertexShader, const std::string& fragmentShader)
+  {
     attachShader(Shader(GL_VERTEX_SHADER));
     shaders_.back().source(vertexShader.c_str());
     shaders_.back().compile();
     attachShader(Shader(GL_FRAGMENT_SHADER));
     shaders_.back().source(fragmentShader.c_str());
     shaders_.back().compile();
-    link();
   }
 
   void Program::attachShader(Shader shader)
@@ -52,43 +75,276 @@ namespace gl
       glGetProgramInfoLog(program_, length_, nullptr, infoLog_.data());
       throw std::runtime_error(infoLog_.data());
     }
+
+    introspectUniforms_();
+  }
+
+  std::vector<uint8_t> Program::getBinary(GLenum& format) const
+  {
+    const Extensions& ext{ Extensions::get() };
+    std::vector<uint8_t> binary;
+    if (!ext.hasProgramBinary())
+    {
+      return binary;
+    }
+    GLint length{ 0 };
+    glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+      return binary;
+    }
+    binary.resize(static_cast<size_t>(length));
+    GLsizei written{ 0 };
+    ext.GetProgramBinary(program_, length, &written, &format, binary.data());
+    binary.resize(static_cast<size_t>(written));
+    return binary;
+  }
+
+  bool Program::loadBinary(GLenum format, const void* data, size_t size)
+  {
+    const Extensions& ext{ Extensions::get() };
+    if (!ext.hasProgramBinary())
+    {
+      return false;
+    }
+    ext.ProgramBinary(program_, format, data, static_cast<GLsizei>(size));
+    int status{ GL_FALSE };
+    glGetProgramiv(program_, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+      return false;
+    }
+    introspectUniforms_();
+    return true;
+  }
+
+  void Program::introspectUniforms_()
+  {
+    uniforms_.clear();
+    uniformNames_.clear();
+    uniformTable_.assign(8, { 0U, -1 });
+
+    int count{ 0 }, maxLength{ 0 };
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> name(static_cast<size_t>(maxLength) + 1);
+    for (int i = 0; i < count; ++i)
+    {
+      GLsizei length{ 0 };
+      GLint size{ 0 };
+      GLenum type{ 0 };
+      glGetActiveUniform(program_, static_cast<GLuint>(i),
+        static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+      const int location{ glGetUniformLocation(program_, name.data()) };
+      if (location < 0)
+      { // uniform block member
+        continue;
+      }
+      const int index{ static_cast<int>(uniforms_.size()) };
+      uniforms_.push_back(UniformInfo{ location, type, {}, false });
+      std::string added{ name.data(), static_cast<size_t>(length) };
+
+      // Arrays are reported as "name[0]", "name" is the same uniform
+      if (added.size() > 3 && added.compare(added.size() - 3, 3, "[0]") == 0)
+      {
+        addUniformName_(added.substr(0, added.size() - 3), index);
+      }
+      addUniformName_(std::move(added), index);
+    }
+  }
+
+  void Program::addUniformName_(std::string name, int index) const
+  {
+    uniformNames_.emplace_back(std::move(name), index);
+
+    // Power of two table, at most half full
+    if (2 * uniformNames_.size() > uniformTable_.size())
+    {
+      uniformTable_.assign(2 * uniformTable_.size(), { 0U, -1 });
+      for (size_t i = 0; i < uniformNames_.size(); ++i)
+      {
+        insertUniformName_(i);
+      }
+    }
+    else
+    {
+      insertUniformName_(uniformNames_.size() - 1);
+    }
+  }
+
+  void Program::insertUniformName_(size_t nameIndex) const
+  {
+    const uint32_t hash{ hashName_(uniformNames_[nameIndex].first.c_str()) };
+    const size_t mask{ uniformTable_.size() - 1 };
+    size_t slot{ hash & mask };
+    while (uniformTable_[slot].second >= 0)
+    {
+      slot = (slot + 1) & mask;
+    }
+    uniformTable_[slot] = { hash, static_cast<int>(nameIndex) };
+  }
+
+  int Program::findUniform_(const char* name) const
+  {
+    if (uniformTable_.empty())
+    { // not linked
+      return -1;
+    }
+    const uint32_t hash{ hashName_(name) };
+    const size_t mask{ uniformTable_.size() - 1 };
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+      const auto& [slotHash, nameIndex] = uniformTable_[slot];
+      if (nameIndex < 0)
+      {
+        break;
+      }
+      const auto& entry{ uniformNames_[static_cast<size_t>(nameIndex)] };
+      if (slotHash == hash && entry.first == name)
+      {
+        return entry.second;
+      }
+    }
+
+    // Only the first element of the arrays is introspected, resolve other
+    //  elements (e.g. "uColors[2]", "uLights[1].position") once and remember
+    //  them, active or not
+    const char* bracket{ std::strrchr(name, '[') };
+    if (!bracket)
+    {
+      return -1;
+    }
+    int index{ -1 };
+    const int location{ glGetUniformLocation(program_, name) };
+    if (location >= 0)
+    {
+      // Same type as the array ("uColors"), or as the first element of the
+      //  arrays of structs ("uLights[0].position")
+      int typeIndex{ findUniform_(std::string{ name, bracket }.c_str()) };
+      if (typeIndex < 0)
+      {
+        const std::string first{ firstElementName_(name) };
+        if (first != name)
+        {
+          typeIndex = findUniform_(first.c_str());
+        }
+      }
+      // Unknown type, not checked
+      const GLenum type{ typeIndex >= 0 ? uniforms_[static_cast<size_t>(typeIndex)].type : GL_NONE };
+      index = static_cast<int>(uniforms_.size());
+      uniforms_.push_back(UniformInfo{ location, type, {}, false });
+    }
+    addUniformName_(name, index);
+    return index;
+  }
+
+  std::string Program::firstElementName_(const char* name)
+  {
+    // "uLights[1].colors[2]" -> "uLights[0].colors[0]"
+    std::string first;
+    for (const char* c = name; *c; ++c)
+    {
+      first += *c;
+      if (*c == '[')
+      {
+        first += '0';
+        while (*c && *c != ']')
+        {
+          ++c;
+        }
+        if (!*c)
+        {
+          break;
+        }
+        first += ']';
+      }
+    }
+    return first;
+  }
+
+  void Program::checkUniformType_(int index, GLenum type, const char* name) const
+  {
+    if (index >= 0 && uniforms_[static_cast<size_t>(index)].type != GL_NONE
+      && uniforms_[static_cast<size_t>(index)].type != type)
+    {
+      throw std::invalid_argument{ std::string{ "Uniform type mismatch: " } + name };
+    }
+  }
+
+  void Program::setUniform_(int index, const float* value, int size) const
+  {
+    UniformInfo& uniform{ uniforms_[static_cast<size_t>(index)] };
+    const size_t bytes{ static_cast<size_t>(size) * sizeof(float) };
+    if (uniform.hasValue && std::memcmp(uniform.value.data(), value, bytes) == 0)
+    { // unchanged, the program keeps its uniform values
+      return;
+    }
+    std::memcpy(uniform.value.data(), value, bytes);
+    uniform.hasValue = true;
+    switch (size)
+    {
+    case 1:
+      glUniform1fv(uniform.location, 1, value);
+      break;
+    case 2:
+      glUniform2fv(uniform.location, 1, value);
+      break;
+    case 3:
+      glUniform3fv(uniform.location, 1, value);
+      break;
+    default:
+      glUniform4fv(uniform.location, 1, value);
+      break;
+    }
   }
 
   void Program::use() const
   {
-    glUseProgram(program_);
+    StateCache::getInstance().useProgram(program_);
   }
 
   void Program::unuse() const
   {
-    glUseProgram(0);
+    StateCache::getInstance().useProgram(0);
   }
 
   void Program::setUniform1f(const char* name, float value) const
   {
-    const int location{ glGetUniformLocation(program_, name) };
-    glUniform1f(location, value);
+    const int index{ findUniform_(name) };
+    if (index >= 0)
+    {
+      setUniform_(index, &value, 1);
+    }
   }
 
   void Program::setUniform2f(
     const char* name, const std::array<float, 2>& value) const
   {
-    const int location{ glGetUniformLocation(program_, name) };
-    glUniform2f(location, value[0], value[1]);
+    const int index{ findUniform_(name) };
+    if (index >= 0)
+    {
+      setUniform_(index, value.data(), 2);
+    }
   }
 
   void Program::setUniform3f(
     const char* name, const std::array<float, 3>& value) const
   {
-    const int location{ glGetUniformLocation(program_, name) };
-    glUniform3f(location, value[0], value[1], value[2]);
+    const int index{ findUniform_(name) };
+    if (index >= 0)
+    {
+      setUniform_(index, value.data(), 3);
+    }
   }
 
   void Program::setUniform4f(
     const char* name, const std::array<float, 4>& value) const
   {
-    const int location{ glGetUniformLocation(program_, name) };
-    glUniform4f(location, value[0], value[1], value[2], value[3]);
+    const int index{ findUniform_(name) };
+    if (index >= 0)
+    {
+      setUniform_(index, value.data(), 4);
+    }
   }
 
 } // namespace gl
@@ -0,0 +1,159 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include <gl/gl.h>
+#include <gl/ProgramCache.hpp>
+#include <gl/Extensions.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace gl
+{
+  namespace
+  {
+    // Header of the binary files, followed by the binary format and the
+    //  program binary
+    constexpr char kBinaryMagic[4]{ 'G', 'L', 'P', 'B' };
+
+    // FNV-1a
+    uint64_t hashBytes_(uint64_t hash, const void* data, size_t size)
+    {
+      const auto* bytes{ static_cast<const unsigned char*>(data) };
+      for (size_t i = 0; i < size; ++i)
+      {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    uint64_t hashString_(uint64_t hash, const char* str)
+    {
+      // Include the terminator so "ab" + "c" and "a" + "bc" differ
+      return str ? hashBytes_(hash, str, std::char_traits<char>::length(str) + 1) : hash;
+    }
+  } // namespace
+
+  ProgramCache& ProgramCache::getInstance()
+  {
+    static ProgramCache instance;
+    return instance;
+  }
+
+  std::shared_ptr<Program> ProgramCache::get(
+    const std::string& vertexShader, const std::string& fragmentShader,
+    const AttributeLocations& attributeLocations)
+  {
+    Key key{ Shader::getShadingLanguageVersion(), vertexShader, fragmentShader, attributeLocations };
+    auto it{ programs_.find(key) };
+    if (it != programs_.end())
+    {
+      if (std::shared_ptr<Program> program = it->second.lock())
+      {
+        return program;
+      }
+    }
+
+    // Drop expired entries while here, so the map does not grow with
+    //  programs that are no longer used
+    for (auto entry = programs_.begin(); entry != programs_.end();)
+    {
+      entry = entry->second.expired() ? programs_.erase(entry) : std::next(entry);
+    }
+
+    std::shared_ptr<Program> program{ build_(key) };
+    programs_[std::move(key)] = program;
+    return program;
+  }
+
+  size_t ProgramCache::size() const
+  {
+    size_t count{ 0 };
+    for (const auto& entry : programs_)
+    {
+      count += entry.second.expired() ? 0 : 1;
+    }
+    return count;
+  }
+
+  uint64_t ProgramCache::hash_(const Key& key)
+  {
+    uint64_t hash{ 14695981039346656037ULL };
+    hash = hashBytes_(hash, &key.glslVersion, sizeof(key.glslVersion));
+    hash = hashString_(hash, key.vertexShader.c_str());
+    hash = hashString_(hash, key.fragmentShader.c_str());
+    for (const auto& [name, location] : key.attributeLocations)
+    {
+      hash = hashString_(hash, name.c_str());
+      hash = hashBytes_(hash, &location, sizeof(location));
+    }
+    return hash;
+  }
+
+  std::string ProgramCache::binaryPath_(const Key& key) const
+  {
+    // Binaries are only valid for the driver that created them
+    uint64_t hash{ hash_(key) };
+    hash = hashString_(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hash = hashString_(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hash = hashString_(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.glpb", static_cast<unsigned long long>(hash));
+    return binaryDirectory_ + "/" + name;
+  }
+
+  std::shared_ptr<Program> ProgramCache::build_(const Key& key) const
+  {
+    auto program{ std::make_shared<Program>() };
+    const bool useBinary{ !binaryDirectory_.empty() && Extensions::get().hasProgramBinary() };
+    const std::string path{ useBinary ? binaryPath_(key) : std::string{} };
+
+    // Warm start: a binary stored by a previous run
+    if (useBinary)
+    {
+      std::ifstream is{ path, std::ios::binary };
+      char magic[sizeof(kBinaryMagic)]{};
+      uint32_t format{ 0 };
+      if (is.read(magic, sizeof(magic)) && std::equal(magic, magic + sizeof(magic), kBinaryMagic)
+        && is.read(reinterpret_cast<char*>(&format), sizeof(format)))
+      {
+        const std::vector<char> binary{ std::istreambuf_iterator<char>{ is }, std::istreambuf_iterator<char>{} };
+        if (!binary.empty() && program->loadBinary(format, binary.data(), binary.size()))
+        {
+          return program;
+        }
+      }
+    }
+
+    program->attachShaders(key.vertexShader, key.fragmentShader);
+    for (const auto& [name, location] : key.attributeLocations)
+    {
+      glBindAttribLocation(program->get(), location, name.c_str());
+    }
+    if (useBinary)
+    {
+      Extensions::get().ProgramParameteri(program->get(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    program->link();
+
+    // Store the binary for the next runs, failures only cost a compilation
+    if (useBinary)
+    {
+      GLenum format{ 0 };
+      const std::vector<uint8_t> binary{ program->getBinary(format) };
+      if (!binary.empty())
+      {
+        std::ofstream os{ path, std::ios::binary | std::ios::trunc };
+        const uint32_t storedFormat{ format };
+        os.write(kBinaryMagic, sizeof(kBinaryMagic));
+        os.write(reinterpret_cast<const char*>(&storedFormat), sizeof(storedFormat));
+        os.write(reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size()));
+      }
+    }
+    return program;
+  }
+
+} // namespace gl
@@ -0,0 +1,229 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include <gl/Scene.hpp>
+#include <gl/StateCache.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace gl
+{
+  Scene::Scene() :
+    entries_{},
+    batches_{},
+    drawList_{},
+    stats_{},
+    initialized_{ false },
+    staticDirty_{ true },
+    drawListDirty_{ true }
+  {
+
+  }
+
+  Scene::~Scene()
+  {
+    deinitGL();
+  }
+
+  void Scene::add(std::shared_ptr<Shape> shape, Usage usage)
+  {
+    if (!shape)
+    {
+      throw std::invalid_argument("Scene: null shape");
+    }
+
+    const Circle* circle{ dynamic_cast<const Circle*>(shape.get()) };
+    if (circle)
+    {
+      std::unique_ptr<CircleBatch>& batch{ batches_[{ circle->getNumSegments(), usage }] };
+      if (!batch)
+      {
+        batch = std::make_unique<CircleBatch>(circle->getNumSegments());
+        if (initialized_)
+        {
+          batch->initGL();
+        }
+      }
+      staticDirty_ = staticDirty_ || usage == Usage::Static;
+    }
+    else if (initialized_)
+    {
+      shape->initGL();
+    }
+
+    entries_.push_back({ std::move(shape), usage, circle });
+    drawListDirty_ = true;
+  }
+
+  void Scene::remove(const std::shared_ptr<Shape>& shape)
+  {
+    const auto it{ std::find_if(entries_.begin(), entries_.end(),
+      [&shape](const Entry& entry) { return entry.shape == shape; }) };
+    if (it != entries_.end())
+    {
+      staticDirty_ = staticDirty_ || (it->circle && it->usage == Usage::Static);
+      entries_.erase(it);
+      drawListDirty_ = true;
+    }
+  }
+
+  void Scene::clear()
+  {
+    entries_.clear();
+    for (auto& batch : batches_)
+    {
+      batch.second->clear();
+    }
+    drawListDirty_ = true;
+  }
+
+  void Scene::initGL()
+  {
+    if (initialized_)
+    { // Already initialized
+      return;
+    }
+
+    for (const Entry& entry : entries_)
+    {
+      if (!entry.circle)
+      {
+        entry.shape->initGL();
+      }
+    }
+    for (auto& batch : batches_)
+    {
+      batch.second->initGL();
+    }
+
+    // Set the initialized flag
+    staticDirty_ = true;
+    drawListDirty_ = true;
+    initialized_ = true;
+  }
+
+  void Scene::deinitGL()
+  {
+    if (initialized_)
+    {
+      for (const Entry& entry : entries_)
+      {
+        if (!entry.circle)
+        {
+          entry.shape->deinitGL();
+        }
+      }
+      for (auto& batch : batches_)
+      {
+        batch.second->deinitGL();
+      }
+      initialized_ = false;
+    }
+  }
+
+  void Scene::fillBatches_()
+  {
+    const bool fillStatic{ staticDirty_ };
+    for (auto& batch : batches_)
+    {
+      if (batch.first.second == Usage::Dynamic || fillStatic)
+      {
+        batch.second->clear();
+      }
+    }
+    for (const Entry& entry : entries_)
+    {
+      if (entry.circle && (entry.usage == Usage::Dynamic || fillStatic))
+      {
+        const Circle& circle{ *entry.circle };
+        batches_[{ circle.getNumSegments(), entry.usage }]->add(
+          circle.getCenter(), circle.getRadius(), circle.getColor());
+      }
+    }
+    staticDirty_ = false;
+  }
+
+  void Scene::sortDrawList_()
+  {
+    drawList_.clear();
+    for (const Entry& entry : entries_)
+    {
+      if (!entry.circle)
+      {
+        drawList_.push_back({ entry.shape.get(), nullptr });
+      }
+    }
+    for (const auto& batch : batches_)
+    {
+      if (batch.second->size() != 0)
+      {
+        drawList_.push_back({ batch.second.get(), batch.second.get() });
+      }
+    }
+
+    // Group by program, keeping the order of the shapes in each group
+    std::stable_sort(drawList_.begin(), drawList_.end(),
+      [](const Item& a, const Item& b)
+      {
+        return std::less<const Program*>{}(a.shape->getProgram(), b.shape->getProgram());
+      });
+    drawListDirty_ = false;
+  }
+
+  void Scene::drawGL()
+  {
+    if (!initialized_)
+    {
+      throw std::runtime_error("Scene not initialized");
+    }
+
+    size_t uploadedBefore{ 0 };
+    for (const auto& batch : batches_)
+    {
+      uploadedBefore += batch.second->getUploadedBytes();
+    }
+
+    fillBatches_();
+    if (drawListDirty_)
+    {
+      sortDrawList_();
+    }
+
+    // State changes are the binds the cache did not elide
+    StateCache& state{ StateCache::getInstance() };
+    const uint64_t issuedBefore{ state.getStats().issued };
+
+    stats_ = {};
+    stats_.shapes = entries_.size();
+    for (const Item& item : drawList_)
+    {
+      if (const Program* program = item.shape->getProgram())
+      {
+        program->use();
+        item.shape->drawBatchedGL();
+      }
+      else
+      {
+        item.shape->drawGL();
+      }
+      stats_.drawCalls += item.batch ? item.batch->getDrawCallCount() : 1;
+    }
+
+    // Restore the default state once for the whole scene
+    state.bindBuffer(GL_ARRAY_BUFFER, 0);
+    state.bindVertexArray(0);
+    state.useProgram(0);
+
+    stats_.stateChanges = static_cast<size_t>(state.getStats().issued - issuedBefore);
+
+    size_t uploadedAfter{ 0 };
+    for (const auto& batch : batches_)
+    {
+      uploadedAfter += batch.second->getUploadedBytes();
+    }
+    stats_.uploadedBytes = uploadedAfter - uploadedBefore;
+  }
+
+} // namespace gl
@@ -2,18 +2,139 @@
 //
 
 #include <gl/Sphere.hpp>
+#include <gl/ProgramCache.hpp>
+#include <gl/StateCache.hpp>
 
+#include <algorithm>
+#include <map>
 #include <stdexcept>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 constexpr static double PI{ 3.14159265358979323846 };
 
 namespace gl
 {
+  // Indexed unit sphere, positions are also the normals
+  struct Sphere::Mesh
+  {
+    GLuint VBO = 0, IBO = 0, VAO = 0;
+    GLsizei indexCount = 0;
+    size_t longitudes = 0;
+
+    Mesh(size_t latitudes, size_t longitudes);
+    ~Mesh();
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+  };
+
+  Sphere::Mesh::Mesh(size_t latitudes, size_t longitudes_) :
+    longitudes{ longitudes_ }
+  {
+    // (latitudes + 1) rings of (longitudes + 1) vertices, the first and last
+    //  vertex of a ring are at the same position for the seam
+    std::vector<float> vertices;
+    vertices.reserve((latitudes + 1) * (longitudes + 1) * 3);
+    for (size_t i = 0; i <= latitudes; ++i)
+    {
+      const double lat{ PI * (-0.5 + static_cast<double>(i) / static_cast<double>(latitudes)) };
+      const double z{ std::sin(lat) };
+      const double zr{ std::cos(lat) };
+      for (size_t j = 0; j <= longitudes; ++j)
+      {
+        const double lng{ 2 * PI * static_cast<double>(j) / static_cast<double>(longitudes) };
+        vertices.push_back(static_cast<float>(zr * std::cos(lng)));
+        vertices.push_back(static_cast<float>(zr * std::sin(lng)));
+        vertices.push_back(static_cast<float>(z));
+      }
+    }
+
+    // Two triangles per quad, one at the poles where the quads collapse
+    std::vector<GLuint> indices;
+    indices.reserve(latitudes * longitudes * 6);
+    const GLuint ring{ static_cast<GLuint>(longitudes + 1) };
+    for (GLuint i = 0; i < latitudes; ++i)
+    {
+      for (GLuint j = 0; j < longitudes; ++j)
+      {
+        const GLuint a{ i * ring + j };   // this ring
+        const GLuint b{ a + ring };       // next ring, towards +z
+        if (i != 0)
+        {
+          indices.insert(indices.end(), { a, a + 1, b });
+        }
+        if (i + 1 != latitudes)
+        {
+          indices.insert(indices.end(), { a + 1, b + 1, b });
+        }
+      }
+    }
+    indexCount = static_cast<GLsizei>(indices.size());
+
+    StateCache& state{ StateCache::getInstance() };
+
+    glGenVertexArrays(1, &VAO);
+    state.bindVertexArray(VAO);
+
+    glGenBuffers(1, &VBO);
+    state.bindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER,
+      sizeof(float)*vertices.size(), vertices.data(), GL_STATIC_DRAW);
+
+    // The element buffer binding is part of the VAO
+    glGenBuffers(1, &IBO);
+    state.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+      sizeof(GLuint)*indices.size(), indices.data(), GL_STATIC_DRAW);
+
+    // Position attribute
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
+    glEnableVertexAttribArray(0);
+
+    // Clean up
+    state.bindVertexArray(0);
+    state.bindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+
+  Sphere::Mesh::~Mesh()
+  {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &IBO);
+    StateCache& state{ StateCache::getInstance() };
+    state.onDeleteVertexArray(VAO);
+    state.onDeleteBuffer(VBO);
+    state.onDeleteBuffer(IBO);
+  }
+
+  std::shared_ptr<const Sphere::Mesh> Sphere::getMesh_(size_t latitudes, size_t longitudes)
+  {
+    // Meshes are released with the last sphere using them
+    static std::map<std::pair<size_t, size_t>, std::weak_ptr<const Mesh>> meshes;
+    std::weak_ptr<const Mesh>& cached{ meshes[{ latitudes, longitudes }] };
+    std::shared_ptr<const Mesh> mesh{ cached.lock() };
+    if (!mesh)
+    {
+      mesh = std::make_shared<const Mesh>(latitudes, longitudes);
+      cached = mesh;
+    }
+    return mesh;
+  }
+
   Sphere::Sphere(size_t latitudes, size_t longitudes) :
     program_{ nullptr },
-    VBO{ 0 },
-    VAO{ 0 },
+    uCenter_{},
+    uRadius_{},
+    uObjectColor_{},
+    uAmbientLightColor_{},
+    uLight0AmbientColor_{},
+    uLight0DiffuseColor_{},
+    uLight0SpecularColor_{},
+    uLight0Position_{},
+    meshes_{},
+    levelOfDetail_{ 0 },
     initialized_{ false },
     latitudes_{ latitudes },
     longitudes_{ longitudes },
@@ -154,27 +275,24 @@ namespace gl
       {
         throw std::runtime_error("Unsupported GLSL version");
       }
-      program_ = std::make_unique<gl::Program>(vertexShader, fragmentShader);
+      program_ = ProgramCache::getInstance().get(vertexShader, fragmentShader);
+      uCenter_ = program_->getUniform<std::array<float, 3>>("uCenter");
+      uRadius_ = program_->getUniform<float>("uRadius");
+      uObjectColor_ = program_->getUniform<std::array<float, 4>>("uObjectColor");
+      uAmbientLightColor_ = program_->getUniform<std::array<float, 4>>("uAmbientLightColor");
+      uLight0AmbientColor_ = program_->getUniform<std::array<float, 4>>("uLight0.ambientColor");
+      uLight0DiffuseColor_ = program_->getUniform<std::array<float, 4>>("uLight0.diffuseColor");
+      uLight0SpecularColor_ = program_->getUniform<std::array<float, 4>>("uLight0.specularColor");
+      uLight0Position_ = program_->getUniform<std::array<float, 3>>("uLight0.position");
     }
 
-    // Configure the vertex buffer object (VBO)
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    const std::vector<float> vertices{ generateVertices_() };
-    glBufferData(GL_ARRAY_BUFFER,
-      sizeof(float)*vertices.size(), vertices.data(), GL_STATIC_DRAW);
-
-    // Configure the vertex array object (VAO)
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
-
-    // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
-    glEnableVertexAttribArray(0);
-
-    // Clean up
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    // Shared meshes, each level halves the tessellation
+    for (size_t level = 0; level < kLevelsOfDetail; ++level)
+    {
+      meshes_[level] = getMesh_(
+        std::max<size_t>(latitudes_ >> level, std::min<size_t>(latitudes_, 4)),
+        std::max<size_t>(longitudes_ >> level, std::min<size_t>(longitudes_, 8)));
+    }
 
     // Set the initialized flag
     initialized_ = true;
@@ -184,8 +302,8 @@ namespace gl
   {
     if (initialized_)
     {
-      glDeleteVertexArrays(1, &VAO);
-      glDeleteBuffers(1, &VBO);
+      meshes_ = {};
+      initialized_ = false;
     }
   }
 
@@ -196,47 +314,53 @@ namespace gl
       throw std::runtime_error("Sphere not initialized");
     }
 
-    // Bind the VAO
-    glBindVertexArray(VAO);
-
-    // Bind the VBO
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
     // Use the shader program
     program_->use();
 
-    // Set the uniforms ---------------------------------------------
+    drawBatchedGL();
+
+    // Unbind the VAO
+    StateCache::getInstance().bindVertexArray(0);
+
+    // Unuse the shader program
+    program_->unuse();
+  }
+
+  void Sphere::drawBatchedGL() const
+  {
+    if (!initialized_)
+    {
+      throw std::runtime_error("Sphere not initialized");
+    }
+
+    // Bind the VAO of the level of detail
+    levelOfDetail_ = selectLevelOfDetail_();
+    const Mesh& mesh{ *meshes_[levelOfDetail_] };
+    StateCache::getInstance().bindVertexArray(mesh.VAO);
+
+    // Set the uniforms (unchanged values are not sent again) --------
 
     // Object attributes
-    program_->setUniform3f("uCenter", center_);
-    program_->setUniform1f("uRadius", radius_);
-    program_->setUniform4f("uObjectColor", color_);
+    uCenter_.set(center_);
+    uRadius_.set(radius_);
+    uObjectColor_.set(color_);
 
     // Ambient light
     const std::array<float, 4> ambientLightColor{ 0.2f, 0.2f, 0.2f, 1.0f };
-    program_->setUniform4f("uAmbientLightColor", ambientLightColor);
+    uAmbientLightColor_.set(ambientLightColor);
 
     // Another light
     const std::array<float, 4> light0_ambientColor{ 0.2f, 0.2f, 0.2f, 1.0f };
     const std::array<float, 4> light0_diffuseColor{ 0.6f, 0.6f, 0.6f, 1.0f };
     const std::array<float, 4> light0_specularColor{ 1.0f, 1.0f, 1.0f, 1.0f };
     const std::array<float, 3> light0_position{ -1.0f, 1.0f, -1.0f };
-    program_->setUniform4f("uLight0.ambientColor", light0_ambientColor);
-    program_->setUniform4f("uLight0.diffuseColor", light0_diffuseColor);
-    program_->setUniform4f("uLight0.specularColor", light0_specularColor);
-    program_->setUniform3f("uLight0.position", light0_position);
-
-    // Draw the vertices
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 3 * latitudes_ * longitudes_);
-
-    // Unbind the VBO
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    // Unbind the VAO
-    glBindVertexArray(0);
+    uLight0AmbientColor_.set(light0_ambientColor);
+    uLight0DiffuseColor_.set(light0_diffuseColor);
+    uLight0SpecularColor_.set(light0_specularColor);
+    uLight0Position_.set(light0_position);
 
-    // Unuse the shader program
-    program_->unuse();
+    // Draw the triangles
+    glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, nullptr);
   }
 
   void Sphere::setColor(float r, float g, float b, float a)
@@ -259,39 +383,24 @@ namespace gl
     center_[2] = z;
   }
 
-  std::vector<float> Sphere::generateVertices_() const
+  size_t Sphere::selectLevelOfDetail_() const
   {
-    std::vector<float> vertices;
-    for (size_t i = 0; i <= latitudes_; ++i)
+    // Radius on screen in pixels, positions are in normalized device
+    //  coordinates
+    const std::array<GLint, 4>& viewport{ StateCache::getInstance().getViewport() };
+    const double radiusPixels{
+      0.5 * static_cast<double>(radius_) * static_cast<double>(std::max(viewport[2], viewport[3])) };
+
+    // Coarsest level whose edges along the equator are at most a few
+    //  pixels long
+    constexpr double kMaxEdgePixels{ 4.0 };
+    const double requiredLongitudes{ 2 * PI * radiusPixels / kMaxEdgePixels };
+    size_t level{ kLevelsOfDetail - 1 };
+    while (level > 0 && static_cast<double>(meshes_[level]->longitudes) < requiredLongitudes)
     {
-      const double lat0{ PI * (-0.5 + static_cast<double>(i - 1) / latitudes_) };
-      const double z0{ std::sin(lat0) };
-      const double zr0{ std::cos(lat0) };
-
-      const double lat1{ PI * (-0.5 + static_cast<double>(i) / latitudes_) };
-      const double z1{ std::sin(lat1) };
-      const double zr1{ std::cos(lat1) };
-
-      for (int j = 0; j <= longitudes_; ++j)
-      {
-        const double lng{ 2 * PI * static_cast<double>(j - 1) / longitudes_ };
-        const double x{ std::cos(lng) };
-        const double y{ std::sin(lng) };
-
-        // position and normal are the same in centered unit sphere
-
-        // vertex 1
-        vertices.emplace_back(static_cast<float>(zr0 * x));
-        vertices.emplace_back(static_cast<float>(zr0 * y));
-        vertices.emplace_back(static_cast<float>(z0));
-
-        // vertex 2
-        vertices.emplace_back(static_cast<float>(zr1 * x));
-        vertices.emplace_back(static_cast<float>(zr1 * y));
-        vertices.emplace_back(static_cast<float>(z1));
-      }
+      --level;
     }
-    return vertices;
+    return level;
   }
 
 } // namespace gl
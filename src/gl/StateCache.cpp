@@ -0,0 +1,239 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include <gl/StateCache.hpp>
+
+namespace gl
+{
+  namespace
+  {
+    constexpr GLenum kNoTextureUnit{ 0 };
+  } // namespace
+
+  StateCache& StateCache::getInstance()
+  {
+    static StateCache instance;
+    return instance;
+  }
+
+  StateCache::StateCache() :
+    program_{ kUnknown },
+    vertexArray_{ kUnknown },
+    buffers_{},
+    drawFramebuffer_{ kUnknown },
+    readFramebuffer_{ kUnknown },
+    viewport_{},
+    viewportKnown_{ false },
+    activeTexture_{ kNoTextureUnit },
+    textures2D_{},
+    stats_{}
+  {
+    invalidate();
+  }
+
+  void StateCache::invalidate()
+  {
+    program_ = kUnknown;
+    vertexArray_ = kUnknown;
+    buffers_.fill(kUnknown);
+    drawFramebuffer_ = kUnknown;
+    readFramebuffer_ = kUnknown;
+    viewportKnown_ = false;
+    activeTexture_ = kNoTextureUnit;
+    textures2D_.fill(kUnknown);
+  }
+
+  bool StateCache::change_(GLuint& current, GLuint value)
+  {
+    if (current == value)
+    {
+      ++stats_.skipped;
+      return false;
+    }
+    current = value;
+    ++stats_.issued;
+    return true;
+  }
+
+  void StateCache::useProgram(GLuint program)
+  {
+    if (change_(program_, program))
+    {
+      glUseProgram(program);
+    }
+  }
+
+  void StateCache::bindVertexArray(GLuint vertexArray)
+  {
+    if (change_(vertexArray_, vertexArray))
+    {
+      glBindVertexArray(vertexArray);
+      buffers_[ElementArrayBuffer] = kUnknown;
+    }
+  }
+
+  void StateCache::bindBuffer(GLenum target, GLuint buffer)
+  {
+    GLuint* current{ nullptr };
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER: current = &buffers_[ArrayBuffer]; break;
+    case GL_ELEMENT_ARRAY_BUFFER: current = &buffers_[ElementArrayBuffer]; break;
+    case GL_PIXEL_PACK_BUFFER: current = &buffers_[PixelPackBuffer]; break;
+    case GL_PIXEL_UNPACK_BUFFER: current = &buffers_[PixelUnpackBuffer]; break;
+    default: break;
+    }
+    if (!current)
+    {
+      ++stats_.issued;
+      glBindBuffer(target, buffer);
+    }
+    else if (change_(*current, buffer))
+    {
+      glBindBuffer(target, buffer);
+    }
+  }
+
+  void StateCache::bindFramebuffer(GLenum target, GLuint framebuffer)
+  {
+    bool changed{ false };
+    switch (target)
+    {
+    case GL_FRAMEBUFFER:
+      // One call sets both
+      changed = drawFramebuffer_ != framebuffer || readFramebuffer_ != framebuffer;
+      drawFramebuffer_ = readFramebuffer_ = framebuffer;
+      if (!changed)
+      {
+        ++stats_.skipped;
+        return;
+      }
+      ++stats_.issued;
+      break;
+    case GL_DRAW_FRAMEBUFFER:
+      changed = change_(drawFramebuffer_, framebuffer);
+      break;
+    case GL_READ_FRAMEBUFFER:
+      changed = change_(readFramebuffer_, framebuffer);
+      break;
+    default:
+      changed = true;
+      ++stats_.issued;
+      break;
+    }
+    if (changed)
+    {
+      glBindFramebuffer(target, framebuffer);
+    }
+  }
+
+  void StateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+  {
+    const std::array<GLint, 4> viewport{ x, y, width, height };
+    if (viewportKnown_ && viewport_ == viewport)
+    {
+      ++stats_.skipped;
+      return;
+    }
+    viewport_ = viewport;
+    viewportKnown_ = true;
+    ++stats_.issued;
+    glViewport(x, y, width, height);
+  }
+
+  const std::array<GLint, 4>& StateCache::getViewport()
+  {
+    if (!viewportKnown_)
+    {
+      glGetIntegerv(GL_VIEWPORT, viewport_.data());
+      viewportKnown_ = true;
+    }
+    return viewport_;
+  }
+
+  void StateCache::activeTexture(GLenum unit)
+  {
+    if (activeTexture_ == unit)
+    {
+      ++stats_.skipped;
+      return;
+    }
+    activeTexture_ = unit;
+    ++stats_.issued;
+    glActiveTexture(unit);
+  }
+
+  void StateCache::bindTexture(GLenum target, GLuint texture)
+  {
+    // The unit is unknown after `invalidate()`
+    if (activeTexture_ == kNoTextureUnit)
+    {
+      GLint unit{ GL_TEXTURE0 };
+      glGetIntegerv(GL_ACTIVE_TEXTURE, &unit);
+      activeTexture_ = static_cast<GLenum>(unit);
+    }
+    const size_t unit{ static_cast<size_t>(activeTexture_ - GL_TEXTURE0) };
+    if (target != GL_TEXTURE_2D || unit >= kTextureUnits)
+    {
+      ++stats_.issued;
+      glBindTexture(target, texture);
+    }
+    else if (change_(textures2D_[unit], texture))
+    {
+      glBindTexture(target, texture);
+    }
+  }
+
+  void StateCache::onDeleteProgram(GLuint program)
+  {
+    // A program in use is only deleted once unused, forget it anyway
+    if (program_ == program)
+    {
+      program_ = kUnknown;
+    }
+  }
+
+  void StateCache::onDeleteVertexArray(GLuint vertexArray)
+  {
+    if (vertexArray_ == vertexArray)
+    {
+      vertexArray_ = 0;
+      buffers_[ElementArrayBuffer] = kUnknown;
+    }
+  }
+
+  void StateCache::onDeleteBuffer(GLuint buffer)
+  {
+    for (GLuint& current : buffers_)
+    {
+      if (current == buffer)
+      {
+        current = 0;
+      }
+    }
+  }
+
+  void StateCache::onDeleteFramebuffer(GLuint framebuffer)
+  {
+    if (drawFramebuffer_ == framebuffer)
+    {
+      drawFramebuffer_ = 0;
+    }
+    if (readFramebuffer_ == framebuffer)
+    {
+      readFramebuffer_ = 0;
+    }
+  }
+
+  void StateCache::onDeleteTexture(GLuint texture)
+  {
+    for (GLuint& current : textures2D_)
+    {
+      if (current == texture)
+      {
+        current = 0;
+      }
+    }
+  }
+
+} // namespace gl
@@ -2,10 +2,16 @@
 //
 
 #include <gui/Application.hpp>
+#include <gui/Profiler.hpp>
+#include <gui/Recorder.hpp>
+#include <gui/Backend.hpp>
+
+#include "impl/FramePacer.hpp"
+#include "impl/TaskQueue.hpp"
 
 #ifdef USE_GUI_TEST_ENGINE
   #include <gui/TestManager.hpp>
-  #include "impl/Backend_Null.hpp"
+  #include <gui/Backend_Null.hpp>
   #include "impl/TestReporter.hpp"
   #include <imgui_te_engine.h>
   #include <imgui_te_ui.h>
@@ -15,7 +21,7 @@
   #include <fstream>
   namespace
   {
-    static ImGuiTestEngine* initTestEngine_()
+    static ImGuiTestEngine* initTestEngine_(gui::Backend* backend)
     {
       // Setup test engine
       ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
@@ -24,8 +30,16 @@
       test_io.ConfigVerboseLevelOnError = ImGuiTestVerboseLevel_Debug;
       //test_io.ConfigRunSpeed = ImGuiTestRunSpeed_Cinematic; // Set to cinematic for debugging
       test_io.ConfigNoThrottle = true; // Disable throttling by default
-      //test_io.ScreenCaptureFunc = ImGuiApp_ScreenCaptureFunc;
-      //test_io.ScreenCaptureUserData = (void*)app;
+      // Screen captures come from the backend (e.g. the software backend
+      //  renders real pixels in headless runs)
+      test_io.ScreenCaptureFunc = [](ImGuiID viewport_id, int x, int y, int w,
+        int h, unsigned int* pixels, void* user_data)
+        {
+          IM_UNUSED(viewport_id);
+          return static_cast<gui::Backend*>(user_data)->CaptureFramebuffer(
+            nullptr, x, y, w, h, pixels, nullptr);
+        };
+      test_io.ScreenCaptureUserData = backend;
       test_io.ConfigLogToTTY = true;
       test_io.ConfigVerboseLevelOnError = ImGuiTestVerboseLevel_Warning;
 
@@ -50,11 +64,24 @@
 
 namespace gui
 {
+  // Number of frames rendered after waking up in power saving mode
+  static constexpr int kRedrawFrames{ 3 };
+
   // static member initialization
   Application* Application::instance_{ nullptr };
 
   Application::Application(const std::string& title, const Vec2i& windowSize) :
-    window_{ std::make_unique<Window>(title, windowSize) }
+    window_{ std::make_unique<Window>(title, windowSize) },
+    running_{ false },
+    redrawFrames_{ kRedrawFrames },
+    powerSaving_{ false },
+    maxIdleWait_{ 1.0 },
+    canWakeUp_{ false },
+    wakeUpsInFlight_{ 0 },
+    tasks_{ std::make_unique<TaskQueue>() },
+    guiThreadId_{},
+    pacer_{ std::make_unique<FramePacer>() },
+    recorder_{ std::make_unique<Recorder>() }
   {
     if (instance_ == nullptr)
     {
@@ -80,20 +107,69 @@ namespace gui
   {
     //init window
     window_->init();
+    canWakeUp_.store(true);
 
   #ifdef USE_GUI_TEST_ENGINE
-    ImGuiTestEngine* engine = initTestEngine_();
+    ImGuiTestEngine* engine = initTestEngine_(window_->getBackendPtr());
   #endif
 
     // main loop
+    guiThreadId_ = std::this_thread::get_id();
     running_ = true;
-    while (running_ && window_->renderBegin())
+    while (running_)
     {
-      window_->render();
+      if (powerSaving_ && redrawFrames_.load() <= 0)
+      { // idle, wait for input or a redraw request
+        window_->waitEvents(maxIdleWait_);
+        redrawFrames_.store(kRedrawFrames);
+        pacer_->reset();
+        if (!running_)
+        {
+          break;
+        }
+      }
+      redrawFrames_.fetch_sub(1);
+
+      GUI_PROFILE_FRAME();
+      GUI_PROFILE_SCOPE("Frame");
+
+      // Run tasks posted from other threads
+      {
+        GUI_PROFILE_SCOPE("Application::runTasks");
+        runTasks_();
+      }
+
+      if (!window_->renderBegin())
+      {
+        break;
+      }
+      {
+        GUI_PROFILE_SCOPE("Window::render");
+        window_->render();
+      }
+      GUI_PROFILE_OVERLAY();
 #if defined(USE_GUI_TEST_ENGINE) && defined(SHOW_TEST_ENGINE_WINDOWS)
       ImGuiTestEngine_ShowTestEngineWindows(engine, NULL);
 #endif
-      window_->renderEnd();
+      const bool rendered{ window_->renderEnd() };
+      if (rendered)
+      { // skipped frames show the previous image, which was already captured
+        recorder_->onFrame(*window_->getBackendPtr());
+      }
+
+      {
+        GUI_PROFILE_SCOPE("Application::pacing");
+        if (rendered)
+        {
+          pacer_->endFrame();
+        }
+        else
+        { // unchanged frame, no swap blocks on vsync: wait for input for up
+          //  to one frame period instead of spinning
+          window_->waitEvents(getSkippedFrameWait_());
+          pacer_->reset();
+        }
+      }
 
 #ifdef USE_GUI_TEST_ENGINE
       // Call after your rendering. This is mostly to support screen/video
@@ -119,7 +195,20 @@ namespace gui
     ImGuiTestEngine_Stop(engine);
   #endif
 
+    guiThreadId_ = std::thread::id{};
+
+    // Flush the recording before the backend is shut down
+    recorder_->stop();
+
     //deinit window
+    // Wait for the wake-ups already past the check before the backend goes
+    //  away. Both sides are sequentially consistent: either the caller sees
+    //  the flag cleared, or this loop sees its count.
+    canWakeUp_.store(false);
+    while (wakeUpsInFlight_.load() != 0)
+    {
+      std::this_thread::yield();
+    }
     window_->deinit();
 
   #ifdef USE_GUI_TEST_ENGINE
@@ -158,6 +247,90 @@ namespace gui
   void Application::quit()
   {
     running_ = false;
+    requestRedraw();
+  }
+
+  void Application::setPowerSaving(bool enable, double maxWaitSeconds)
+  {
+    powerSaving_ = enable;
+    maxIdleWait_ = maxWaitSeconds;
+  }
+
+  void Application::requestRedraw()
+  {
+    redrawFrames_.store(kRedrawFrames);
+    wakeUpsInFlight_.fetch_add(1);
+    if (canWakeUp_.load())
+    {
+      window_->wakeUp();
+    }
+    wakeUpsInFlight_.fetch_sub(1);
+  }
+
+  void Application::post(std::function<void()> task)
+  {
+    tasks_->push(std::move(task));
+    requestRedraw();
+  }
+
+  void Application::dispatch(std::function<void()> task)
+  {
+    if (guiThreadId_.load() == std::this_thread::get_id())
+    {
+      task();
+    }
+    else
+    {
+      post(std::move(task));
+    }
+  }
+
+  void Application::invalidate()
+  {
+    window_->invalidate();
+    requestRedraw();
+  }
+
+  void Application::setTargetFps(double fps)
+  {
+    pacer_->setTargetFps(fps);
+  }
+
+  double Application::getTargetFps() const
+  {
+    return pacer_->getTargetFps();
+  }
+
+  Application::FrameStats Application::getFrameStats() const
+  {
+    return pacer_->getStats();
+  }
+
+  double Application::getSkippedFrameWait_() const
+  {
+    // The target frame rate if capped, otherwise the display refresh rate
+    const double targetFps{ pacer_->getTargetFps() };
+    const double fps{ targetFps > 0.0
+      ? targetFps : static_cast<double>(window_->getBackendPtr()->RefreshRate) };
+    return 1.0 / (fps > 0.0 ? fps : 60.0);
+  }
+
+  void Application::runTasks_()
+  {
+    // Only the tasks queued before the drain: tasks posted meanwhile (e.g.
+    //  a task posting itself, or a fast producer) run on the next frame, so
+    //  the frame is never held up
+    size_t count{ tasks_->size() };
+    std::function<void()> task;
+    while (count > 0 && tasks_->pop(task))
+    {
+      --count;
+      task();
+    }
+    if (tasks_->size() > 0)
+    {
+      requestRedraw();
+    }
   }
 
 } // namespace support
@@ -32,8 +32,12 @@ namespace gui
   bool ChildFrame::renderBegin()
   {
     ImGui::SetNextWindowPos(getPosition().to<float>());
+    // Use the pre-hashed identifier instead of hashing the name every frame.
+    //  It is still combined with the parent ID stack (4 bytes hashed), so
+    //  child frames with the same name in different parents do not collide.
     return ImGui::BeginChild(
-      getName().c_str(), getSize().to<float>(), childFlags_, windowFlags_);
+      ImGui::GetID(static_cast<int>(getId())),
+      getSize().to<float>(), childFlags_, windowFlags_);
   }
 
   void ChildFrame::renderEnd()
@@ -4,29 +4,11 @@
 #include <gui/Frame.hpp>
 #include <gui/Window.hpp>
 #include <gui/Application.hpp>
+#include <gui/LayoutBuilder.hpp>
+#include <gui/Sizer.hpp>
 
 #include <imgui.h>
 
-namespace
-{
-  std::string generateIdentifier_(uint64_t seed, size_t length = 4)
-  {
-    const char alphanum[] =
-        "0123456789"
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-        "abcdefghijklmnopqrstuvwxyz";
-
-    std::string result;
-    std::srand(seed);
-
-    for (size_t i = 0; i < length; ++i) {
-        result += alphanum[std::rand() % (sizeof(alphanum) - 1)];
-    }
-
-    return result;
-  }
-}
-
 namespace gui
 {
   static constexpr int kDefaultFlags{
@@ -40,7 +22,8 @@ namespace gui
     const Vec2i& size,
     int flags) :
       Widget{name, pos, size},
-      flags_{ flags < 0 ? kDefaultFlags : flags}
+      flags_{ flags < 0 ? kDefaultFlags : flags},
+      layout_{ nullptr }
   {
     if (auto app = Application::getInstancePtr())
     {
@@ -61,7 +44,14 @@ namespace gui
     ImGui::SetNextWindowPos(getPosition().to<float>());
     ImGui::SetNextWindowSize(getSize().to<float>());
     ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0.0f);
-    return ImGui::Begin(getName().c_str(), nullptr, flags_);
+    // Top-level windows can only be looked up by name, ImGui::Begin() has
+    //  no identifier based overload
+    const bool visible{ ImGui::Begin(getName().c_str(), nullptr, flags_) };
+    if (visible && layout_)
+    {
+      layout_->setBounds(getContentMin(), getContentSize());
+    }
+    return visible;
   }
 
   void Frame::renderEnd()
@@ -75,4 +65,17 @@ namespace gui
 
   }
 
+  void Frame::setLayout(std::unique_ptr<Layout> layout)
+  {
+    if (layout_ && layout_->getRoot())
+    {
+      removeChild(layout_->getRoot());
+    }
+    layout_ = std::move(layout);
+    if (layout_ && layout_->getRoot())
+    {
+      addChild(layout_->getRoot());
+    }
+  }
+
 } // namespace gui
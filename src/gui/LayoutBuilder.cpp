@@ -0,0 +1,146 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include <gui/LayoutBuilder.hpp>
+#include <gui/VerticalSizer.hpp>
+#include <gui/HorizontalSizer.hpp>
+
+#include <stdexcept>
+
+namespace gui
+{
+  Layout::Layout() :
+    widgets_{},
+    root_{ nullptr }
+  {
+  }
+
+  Layout::~Layout()
+  {
+  }
+
+  void Layout::setBounds(const Vec2i& pos, const Vec2i& size)
+  {
+    if (root_)
+    {
+      root_->setPosition(pos);
+      root_->setSize(size);
+    }
+  }
+
+  LayoutBuilder::LayoutBuilder() :
+    layout_{ std::make_unique<Layout>() },
+    stack_{}
+  {
+  }
+
+  LayoutBuilder::~LayoutBuilder()
+  {
+  }
+
+  LayoutBuilder& LayoutBuilder::beginVertical(int weight)
+  {
+    return begin_(std::make_unique<VerticalSizer>(), weight);
+  }
+
+  LayoutBuilder& LayoutBuilder::beginHorizontal(int weight)
+  {
+    return begin_(std::make_unique<HorizontalSizer>(), weight);
+  }
+
+  LayoutBuilder& LayoutBuilder::end()
+  {
+    if (stack_.empty())
+    {
+      throw std::logic_error{ "end() without a matching begin" };
+    }
+    stack_.pop_back();
+    return *this;
+  }
+
+  LayoutBuilder& LayoutBuilder::add(Widget* child, int weight)
+  {
+    current_(child).addChild(child, weight);
+    return *this;
+  }
+
+  LayoutBuilder& LayoutBuilder::addFixed(Widget* child, int size)
+  {
+    if (size < 0)
+    {
+      throw std::invalid_argument{ "size cannot be negative" };
+    }
+    current_(child).addWithFixedSize(child, size);
+    return *this;
+  }
+
+  LayoutBuilder& LayoutBuilder::add(std::unique_ptr<Widget> child, int weight)
+  {
+    add(child.get(), weight);
+    layout_->widgets_.push_back(std::move(child));
+    return *this;
+  }
+
+  LayoutBuilder& LayoutBuilder::addFixed(std::unique_ptr<Widget> child, int size)
+  {
+    addFixed(child.get(), size);
+    layout_->widgets_.push_back(std::move(child));
+    return *this;
+  }
+
+  std::unique_ptr<Layout> LayoutBuilder::build()
+  {
+    if (!layout_)
+    {
+      throw std::logic_error{ "layout was already built" };
+    }
+    if (!stack_.empty())
+    {
+      throw std::logic_error{ "begin() without a matching end" };
+    }
+    return std::move(layout_);
+  }
+
+  LayoutBuilder& LayoutBuilder::begin_(
+    std::unique_ptr<StackingSizer> sizer, int weight)
+  {
+    if (!layout_)
+    {
+      throw std::logic_error{ "layout was already built" };
+    }
+    StackingSizer* sizerPtr{ sizer.get() };
+    if (stack_.empty())
+    {
+      if (layout_->root_)
+      {
+        throw std::logic_error{ "layout can only have one root sizer" };
+      }
+      layout_->root_ = sizerPtr;
+    }
+    else
+    {
+      add(sizerPtr, weight);
+    }
+    layout_->widgets_.push_back(std::move(sizer));
+    stack_.push_back(sizerPtr);
+    return *this;
+  }
+
+  StackingSizer& LayoutBuilder::current_(Widget* child)
+  {
+    if (!layout_)
+    {
+      throw std::logic_error{ "layout was already built" };
+    }
+    if (stack_.empty())
+    {
+      throw std::logic_error{ "widgets must be added inside a sizer" };
+    }
+    if (child == nullptr)
+    {
+      throw std::invalid_argument{ "child cannot be null" };
+    }
+    return *stack_.back();
+  }
+
+} // namespace gui
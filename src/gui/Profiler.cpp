@@ -0,0 +1,330 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include <gui/Profiler.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cfloat>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace gui
+{
+  // Number of frame times shown in the overlay plot
+  static constexpr size_t kFrameHistorySize{ 120 };
+
+  static_assert((Profiler::kCapacity & (Profiler::kCapacity - 1)) == 0,
+    "kCapacity must be a power of two");
+
+  namespace
+  {
+    // Small per-thread identifiers for the trace
+    uint32_t threadIndex_()
+    {
+      static std::atomic<uint32_t> nextIndex{ 0 };
+      thread_local const uint32_t index{ nextIndex.fetch_add(1) };
+      return index;
+    }
+
+    // Nesting depth of the zones of the current thread
+    thread_local uint32_t depth_{ 0 };
+
+    void writeJsonString_(std::ostream& os, const char* str)
+    {
+      os << '"';
+      for (; *str; ++str)
+      {
+        const char c{ *str };
+        if (c == '"' || c == '\\')
+        {
+          os << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+          os << escaped;
+        }
+        else
+        {
+          os << c;
+        }
+      }
+      os << '"';
+    }
+
+    bool earlierBegin_(const Profiler::Zone& a, const Profiler::Zone& b)
+    {
+      return a.beginNs < b.beginNs || (a.beginNs == b.beginNs && a.depth < b.depth);
+    }
+  } // namespace
+
+  Profiler::Scope::Scope(const char* name, const char* label) :
+    name_{ name },
+    label_{ label },
+    frame_{ 0 },
+    beginNs_{ 0 }
+  {
+    Profiler& profiler{ getInstance() };
+    if (profiler.isEnabled())
+    {
+      frame_ = profiler.getFrame();
+      beginNs_ = now();
+      ++depth_;
+    }
+  }
+
+  Profiler::Scope::~Scope()
+  {
+    if (beginNs_ != 0)
+    {
+      --depth_;
+      getInstance().record(name_, label_, frame_, beginNs_, now(), depth_);
+    }
+  }
+
+  Profiler& Profiler::getInstance()
+  {
+    static Profiler instance;
+    return instance;
+  }
+
+  Profiler::Profiler() :
+    enabled_{ true },
+    frame_{ 0 },
+    frameThread_{ 0 },
+    head_{ 0 },
+    slots_{ std::make_unique<Slot[]>(kCapacity) },
+    overlayVisible_{ false },
+    frameHistoryMs_{}
+  {
+    frameHistoryMs_.reserve(kFrameHistorySize);
+  }
+
+  uint64_t Profiler::now()
+  {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  void Profiler::beginFrame()
+  {
+    frameThread_.store(threadIndex_(), std::memory_order_relaxed);
+    frame_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Profiler::record(const char* name, const char* label,
+    uint64_t frame, uint64_t beginNs, uint64_t endNs, uint32_t depth)
+  {
+    // Claim a slot, then publish it with a sequence lock so readers can
+    //  detect slots overwritten while being read
+    const uint64_t index{ head_.fetch_add(1, std::memory_order_relaxed) };
+    Slot& slot{ slots_[index & (kCapacity - 1)] };
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Zone& zone{ slot.zone };
+    zone.name = name;
+    if (label)
+    {
+      std::strncpy(zone.label, label, kLabelSize - 1);
+      zone.label[kLabelSize - 1] = '\0';
+    }
+    else
+    {
+      zone.label[0] = '\0';
+    }
+    zone.frame = frame;
+    zone.beginNs = beginNs;
+    zone.endNs = endNs;
+    zone.thread = threadIndex_();
+    zone.depth = depth;
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+  }
+
+  bool Profiler::readSlot_(size_t index, Zone& zone) const
+  {
+    const Slot& slot{ slots_[index & (kCapacity - 1)] };
+    const uint64_t expected{ 2 * static_cast<uint64_t>(index) + 2 };
+    if (slot.sequence.load(std::memory_order_acquire) != expected)
+    { // being written, or already overwritten
+      return false;
+    }
+    zone = slot.zone;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == expected;
+  }
+
+  std::vector<Profiler::Zone> Profiler::getZones() const
+  {
+    const uint64_t head{ head_.load(std::memory_order_acquire) };
+    const uint64_t first{ head > kCapacity ? head - kCapacity : 0 };
+
+    std::vector<Zone> zones;
+    zones.reserve(static_cast<size_t>(head - first));
+    Zone zone;
+    for (uint64_t index = first; index < head; ++index)
+    {
+      if (readSlot_(static_cast<size_t>(index), zone))
+      {
+        zones.push_back(zone);
+      }
+    }
+    std::sort(zones.begin(), zones.end(), earlierBegin_);
+    return zones;
+  }
+
+  std::vector<Profiler::Zone> Profiler::getZones(uint64_t frame) const
+  {
+    // Zones are recorded when they end, so the zones of a frame are at the
+    //  end of the buffer: walk backwards until an older frame of the frame
+    //  thread is found. Other threads can end a zone of an older frame late,
+    //  those are skipped.
+    const uint32_t frameThread{ frameThread_.load(std::memory_order_relaxed) };
+    const uint64_t head{ head_.load(std::memory_order_acquire) };
+    const uint64_t first{ head > kCapacity ? head - kCapacity : 0 };
+
+    std::vector<Zone> zones;
+    Zone zone;
+    for (uint64_t index = head; index > first; --index)
+    {
+      if (!readSlot_(static_cast<size_t>(index - 1), zone))
+      {
+        continue;
+      }
+      if (zone.frame < frame && zone.thread == frameThread)
+      {
+        break;
+      }
+      if (zone.frame == frame)
+      {
+        zones.push_back(zone);
+      }
+    }
+    std::sort(zones.begin(), zones.end(), earlierBegin_);
+    return zones;
+  }
+
+  void Profiler::writeChromeTrace(std::ostream& os) const
+  {
+    const std::vector<Zone> zones{ getZones() };
+
+    // Complete ("X") events, timestamps in microseconds
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first{ true };
+    char number[64];
+    for (const Zone& zone : zones)
+    {
+      os << (first ? "\n" : ",\n");
+      first = false;
+      os << "{\"name\":";
+      writeJsonString_(os, zone.label[0] ? zone.label : zone.name);
+      os << ",\"cat\":";
+      writeJsonString_(os, zone.name);
+      std::snprintf(number, sizeof(number), "%.3f",
+        static_cast<double>(zone.beginNs) / 1000.0);
+      os << ",\"ph\":\"X\",\"ts\":" << number;
+      std::snprintf(number, sizeof(number), "%.3f",
+        static_cast<double>(zone.endNs - zone.beginNs) / 1000.0);
+      os << ",\"dur\":" << number;
+      os << ",\"pid\":0,\"tid\":" << zone.thread;
+      os << ",\"args\":{\"frame\":" << zone.frame << "}}";
+    }
+    os << "\n]}\n";
+  }
+
+  void Profiler::writeChromeTrace(const std::string& filename) const
+  {
+    std::ofstream os{ filename };
+    if (!os)
+    {
+      throw std::runtime_error{ "Cannot open trace file: " + filename };
+    }
+    writeChromeTrace(os);
+  }
+
+  void Profiler::drawOverlay()
+  {
+    if (!overlayVisible_)
+    {
+      return;
+    }
+
+    // The current frame is still being recorded, show the previous one
+    const uint64_t frame{ getFrame() };
+    const std::vector<Zone> zones{ frame > 0 ? getZones(frame - 1) : std::vector<Zone>{} };
+
+    // Frame time history, from the outermost zone of each frame
+    for (const Zone& zone : zones)
+    {
+      if (zone.depth == 0)
+      {
+        if (frameHistoryMs_.size() == kFrameHistorySize)
+        {
+          frameHistoryMs_.erase(frameHistoryMs_.begin());
+        }
+        frameHistoryMs_.push_back(static_cast<float>(zone.endNs - zone.beginNs) * 1e-6f);
+        break;
+      }
+    }
+
+    ImGui::SetNextWindowSize(ImVec2(360.0f, 420.0f), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Profiler", &overlayVisible_))
+    {
+      bool enabled{ isEnabled() };
+      if (ImGui::Checkbox("Record", &enabled))
+      {
+        setEnabled(enabled);
+      }
+      ImGui::SameLine();
+      if (ImGui::Button("Save trace"))
+      {
+        writeChromeTrace("gui_trace.json");
+      }
+
+      if (!frameHistoryMs_.empty())
+      {
+        ImGui::Text("Frame %llu: %.3f ms",
+          static_cast<unsigned long long>(frame - 1), frameHistoryMs_.back());
+        ImGui::PlotLines("##frame_times", frameHistoryMs_.data(),
+          static_cast<int>(frameHistoryMs_.size()), 0, "frame time [ms]",
+          0.0f, FLT_MAX, ImVec2(-1.0f, 60.0f));
+      }
+
+      if (ImGui::BeginTable("zones", 2,
+        ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable))
+      {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_WidthFixed, 64.0f);
+        ImGui::TableHeadersRow();
+        for (const Zone& zone : zones)
+        {
+          ImGui::TableNextRow();
+          ImGui::TableNextColumn();
+          ImGui::Indent(static_cast<float>(zone.depth) * 8.0f + 1.0f);
+          if (zone.label[0])
+          {
+            ImGui::Text("%s (%s)", zone.name, zone.label);
+          }
+          else
+          {
+            ImGui::TextUnformatted(zone.name);
+          }
+          ImGui::Unindent(static_cast<float>(zone.depth) * 8.0f + 1.0f);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.3f", static_cast<double>(zone.endNs - zone.beginNs) * 1e-6);
+        }
+        ImGui::EndTable();
+      }
+    }
+    ImGui::End();
+  }
+
+} // namespace gui
@@ -0,0 +1,724 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include <gui/Recorder.hpp>
+
+#include <gui/Backend.hpp>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+# include <signal.h>
+# define RECORDER_POSIX_
+#endif
+
+#ifdef _WIN32
+# define popen _popen
+# define pclose _pclose
+# define RECORDER_PIPE_MODE_ "wb"
+#else
+# define RECORDER_PIPE_MODE_ "w"
+#endif
+
+namespace gui
+{
+  namespace
+  {
+    void replaceAll_(std::string& str, const std::string& from, const std::string& to)
+    {
+      for (size_t pos = str.find(from); pos != std::string::npos; pos = str.find(from, pos + to.size()))
+      {
+        str.replace(pos, from.size(), to);
+      }
+    }
+
+    void writeAll_(std::FILE* file, const void* data, size_t size)
+    {
+      if (std::fwrite(data, 1, size, file) != size)
+      {
+        throw std::runtime_error{ "Recorder: write failed" };
+      }
+    }
+
+    // PNG encoding ------------------------------------------------------------
+
+    uint32_t crc32_(uint32_t crc, const uint8_t* data, size_t size)
+    {
+      static const std::array<uint32_t, 256> table{ []()
+        {
+          std::array<uint32_t, 256> t{};
+          for (uint32_t n = 0; n < 256; ++n)
+          {
+            uint32_t c{ n };
+            for (int k = 0; k < 8; ++k)
+            {
+              c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+          }
+          return t;
+        }() };
+      crc = ~crc;
+      for (size_t i = 0; i < size; ++i)
+      {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+      }
+      return ~crc;
+    }
+
+    uint32_t adler32_(const uint8_t* data, size_t size)
+    {
+      uint32_t a{ 1 }, b{ 0 };
+      while (size > 0)
+      {
+        // Largest block that cannot overflow before the modulo
+        const size_t block{ std::min<size_t>(size, 5552) };
+        for (size_t i = 0; i < block; ++i)
+        {
+          a += data[i];
+          b += a;
+        }
+        a %= 65521U;
+        b %= 65521U;
+        data += block;
+        size -= block;
+      }
+      return (b << 16) | a;
+    }
+
+    // Deflate with the fixed Huffman codes. Matches are only searched at the
+    //  previous byte and at the same byte of the previous row, which is
+    //  enough for the large flat areas of a GUI after the "Sub" filter.
+    class Deflate
+    {
+      std::vector<uint8_t>& out_;
+      uint64_t bits_;
+      int count_;
+
+      void putBits_(uint32_t value, int n)
+      {
+        bits_ |= static_cast<uint64_t>(value) << count_;
+        count_ += n;
+        while (count_ >= 8)
+        {
+          out_.push_back(static_cast<uint8_t>(bits_));
+          bits_ >>= 8;
+          count_ -= 8;
+        }
+      }
+
+      // Huffman codes are stored most significant bit first
+      void putCode_(uint32_t code, int n)
+      {
+        uint32_t reversed{ 0 };
+        for (int i = 0; i < n; ++i)
+        {
+          reversed |= ((code >> i) & 1U) << (n - 1 - i);
+        }
+        putBits_(reversed, n);
+      }
+
+      void putSymbol_(uint32_t symbol)
+      {
+        if (symbol < 144)
+        {
+          putCode_(0x30 + symbol, 8);
+        }
+        else if (symbol < 256)
+        {
+          putCode_(0x190 + (symbol - 144), 9);
+        }
+        else if (symbol < 280)
+        {
+          putCode_(symbol - 256, 7);
+        }
+        else
+        {
+          putCode_(0xC0 + (symbol - 280), 8);
+        }
+      }
+
+      void putMatch_(uint32_t length, uint32_t distance)
+      {
+        static constexpr uint16_t kLengthBase[29]{ 3, 4, 5, 6, 7, 8, 9, 10, 11, 13,
+          15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static constexpr uint8_t kLengthExtra[29]{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+          1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static constexpr uint16_t kDistanceBase[30]{ 1, 2, 3, 4, 5, 7, 9, 13, 17, 25,
+          33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+          4097, 6145, 8193, 12289, 16385, 24577 };
+        static constexpr uint8_t kDistanceExtra[30]{ 0, 0, 0, 0, 1, 1, 2, 2, 3, 3,
+          4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+        uint32_t l{ 28 };
+        while (kLengthBase[l] > length)
+        {
+          --l;
+        }
+        putSymbol_(257 + l);
+        putBits_(length - kLengthBase[l], kLengthExtra[l]);
+
+        uint32_t d{ 29 };
+        while (kDistanceBase[d] > distance)
+        {
+          --d;
+        }
+        putCode_(d, 5);
+        putBits_(distance - kDistanceBase[d], kDistanceExtra[d]);
+      }
+
+      static uint32_t matchLength_(const uint8_t* data, size_t pos, size_t size, size_t distance)
+      {
+        const size_t limit{ std::min<size_t>(258, size - pos) };
+        size_t length{ 0 };
+        while (length < limit && data[pos + length] == data[pos + length - distance])
+        {
+          ++length;
+        }
+        return static_cast<uint32_t>(length);
+      }
+
+    public:
+      explicit Deflate(std::vector<uint8_t>& out) : out_{ out }, bits_{ 0 }, count_{ 0 } {}
+
+      void compress(const uint8_t* data, size_t size, size_t rowSize)
+      {
+        // Single final block with the fixed codes
+        putBits_(1, 1);
+        putBits_(1, 2);
+        const bool useRow{ rowSize <= 32768 };
+        for (size_t pos = 0; pos < size;)
+        {
+          uint32_t length{ 0 }, distance{ 0 };
+          if (pos >= 1)
+          {
+            length = matchLength_(data, pos, size, 1);
+            distance = 1;
+          }
+          if (useRow && pos >= rowSize)
+          {
+            const uint32_t rowLength{ matchLength_(data, pos, size, rowSize) };
+            if (rowLength > length)
+            {
+              length = rowLength;
+              distance = static_cast<uint32_t>(rowSize);
+            }
+          }
+          if (length >= 3)
+          {
+            putMatch_(length, distance);
+            pos += length;
+          }
+          else
+          {
+            putSymbol_(data[pos]);
+            ++pos;
+          }
+        }
+        putSymbol_(256);
+        if (count_ > 0)
+        {
+          putBits_(0, 8 - count_);
+        }
+      }
+    };
+
+    void putBigEndian_(std::vector<uint8_t>& out, uint32_t value)
+    {
+      out.push_back(static_cast<uint8_t>(value >> 24));
+      out.push_back(static_cast<uint8_t>(value >> 16));
+      out.push_back(static_cast<uint8_t>(value >> 8));
+      out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void putChunk_(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size)
+    {
+      putBigEndian_(out, static_cast<uint32_t>(size));
+      const size_t start{ out.size() };
+      out.insert(out.end(), type, type + 4);
+      out.insert(out.end(), data, data + size);
+      putBigEndian_(out, crc32_(0, &out[start], out.size() - start));
+    }
+  } // namespace
+
+  // Encoders ------------------------------------------------------------------
+
+  class Recorder::Encoder
+  {
+  public:
+    virtual ~Encoder() = default;
+    // Encode one RGBA8 frame, returns the number of bytes written. Throws
+    //  on errors.
+    virtual size_t write(const uint32_t* pixels, int w, int h, uint64_t index) = 0;
+    virtual void close() {}
+  };
+
+  namespace
+  {
+    class Y4mEncoder : public Recorder::Encoder
+    {
+      std::FILE* file_;
+      double fps_;
+      bool headerWritten_;
+      std::vector<uint8_t> planes_;
+    public:
+      Y4mEncoder(const std::string& filename, double fps) :
+        file_{ std::fopen(filename.c_str(), "wb") },
+        fps_{ fps },
+        headerWritten_{ false },
+        planes_{}
+      {
+        if (file_ == nullptr)
+        {
+          throw std::runtime_error{ "Cannot create recording: " + filename };
+        }
+      }
+
+      ~Y4mEncoder() override
+      {
+        close();
+      }
+
+      size_t write(const uint32_t* pixels, int w, int h, uint64_t) override
+      {
+        size_t bytes{ 0 };
+        if (!headerWritten_)
+        {
+          char header[128];
+          const int length{ std::snprintf(header, sizeof(header),
+            "YUV4MPEG2 W%d H%d F%ld:1000 Ip A1:1 C420jpeg\n",
+            w, h, std::lround(fps_ * 1000.0)) };
+          writeAll_(file_, header, static_cast<size_t>(length));
+          bytes += static_cast<size_t>(length);
+          headerWritten_ = true;
+        }
+
+        // BT.601 limited range, chroma averaged over 2x2 pixels (the size
+        //  is even)
+        const size_t width{ static_cast<size_t>(w) };
+        const size_t height{ static_cast<size_t>(h) };
+        const size_t lumaSize{ width * height };
+        const size_t chromaSize{ lumaSize / 4 };
+        planes_.resize(lumaSize + 2 * chromaSize);
+        uint8_t* yPlane{ planes_.data() };
+        uint8_t* uPlane{ yPlane + lumaSize };
+        uint8_t* vPlane{ uPlane + chromaSize };
+        for (size_t y = 0; y < height; y += 2)
+        {
+          const uint8_t* row0{ reinterpret_cast<const uint8_t*>(pixels + y * width) };
+          const uint8_t* row1{ row0 + width * 4 };
+          for (size_t x = 0; x < width; x += 2)
+          {
+            int r{ 0 }, g{ 0 }, b{ 0 };
+            const uint8_t* quad[4]{ row0 + x * 4, row0 + x * 4 + 4, row1 + x * 4, row1 + x * 4 + 4 };
+            for (int i = 0; i < 4; ++i)
+            {
+              const int pr{ quad[i][0] }, pg{ quad[i][1] }, pb{ quad[i][2] };
+              yPlane[(y + static_cast<size_t>(i / 2)) * width + x + static_cast<size_t>(i % 2)] =
+                static_cast<uint8_t>(((66 * pr + 129 * pg + 25 * pb + 128) >> 8) + 16);
+              r += pr;
+              g += pg;
+              b += pb;
+            }
+            r = (r + 2) / 4;
+            g = (g + 2) / 4;
+            b = (b + 2) / 4;
+            const size_t c{ (y / 2) * (width / 2) + x / 2 };
+            uPlane[c] = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            vPlane[c] = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+          }
+        }
+
+        static constexpr char kFrame[]{ "FRAME\n" };
+        writeAll_(file_, kFrame, sizeof(kFrame) - 1);
+        writeAll_(file_, planes_.data(), planes_.size());
+        return bytes + sizeof(kFrame) - 1 + planes_.size();
+      }
+
+      void close() override
+      {
+        if (file_)
+        {
+          const bool failed{ std::fclose(file_) != 0 };
+          file_ = nullptr;
+          if (failed)
+          {
+            throw std::runtime_error{ "Recorder: cannot close the recording" };
+          }
+        }
+      }
+    };
+
+    class PngEncoder : public Recorder::Encoder
+    {
+      std::string pattern_;
+      std::vector<uint8_t> filtered_;
+      std::vector<uint8_t> compressed_;
+      std::vector<uint8_t> file_;
+    public:
+      explicit PngEncoder(const std::string& pattern) : pattern_{ pattern } {}
+
+      size_t write(const uint32_t* pixels, int w, int h, uint64_t index) override
+      {
+        // "Sub" filter: each byte minus the same channel of the previous pixel
+        const size_t rowSize{ static_cast<size_t>(w) * 4 + 1 };
+        filtered_.resize(rowSize * static_cast<size_t>(h));
+        for (size_t y = 0; y < static_cast<size_t>(h); ++y)
+        {
+          const uint8_t* src{ reinterpret_cast<const uint8_t*>(pixels + y * static_cast<size_t>(w)) };
+          uint8_t* dst{ &filtered_[y * rowSize] };
+          dst[0] = 1;
+          std::memcpy(dst + 1, src, 4);
+          for (size_t i = 4; i < rowSize - 1; ++i)
+          {
+            dst[i + 1] = static_cast<uint8_t>(src[i] - src[i - 4]);
+          }
+        }
+
+        // zlib stream
+        compressed_.clear();
+        compressed_.push_back(0x78);
+        compressed_.push_back(0x01);
+        Deflate{ compressed_ }.compress(filtered_.data(), filtered_.size(), rowSize);
+        putBigEndian_(compressed_, adler32_(filtered_.data(), filtered_.size()));
+
+        static constexpr uint8_t kSignature[8]{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        file_.assign(kSignature, kSignature + sizeof(kSignature));
+        uint8_t header[13]{};
+        header[0] = static_cast<uint8_t>(static_cast<uint32_t>(w) >> 24);
+        header[1] = static_cast<uint8_t>(static_cast<uint32_t>(w) >> 16);
+        header[2] = static_cast<uint8_t>(static_cast<uint32_t>(w) >> 8);
+        header[3] = static_cast<uint8_t>(w);
+        header[4] = static_cast<uint8_t>(static_cast<uint32_t>(h) >> 24);
+        header[5] = static_cast<uint8_t>(static_cast<uint32_t>(h) >> 16);
+        header[6] = static_cast<uint8_t>(static_cast<uint32_t>(h) >> 8);
+        header[7] = static_cast<uint8_t>(h);
+        header[8] = 8; // bit depth
+        header[9] = 6; // RGBA
+        putChunk_(file_, "IHDR", header, sizeof(header));
+        putChunk_(file_, "IDAT", compressed_.data(), compressed_.size());
+        putChunk_(file_, "IEND", nullptr, 0);
+
+        char number[32];
+        std::snprintf(number, sizeof(number), "%06llu", static_cast<unsigned long long>(index));
+        std::string filename{ pattern_ };
+        replaceAll_(filename, "{frame}", number);
+        std::FILE* file{ std::fopen(filename.c_str(), "wb") };
+        if (file == nullptr)
+        {
+          throw std::runtime_error{ "Cannot create recording: " + filename };
+        }
+        const bool written{ std::fwrite(file_.data(), 1, file_.size(), file) == file_.size() };
+        if (std::fclose(file) != 0 || !written)
+        {
+          throw std::runtime_error{ "Recorder: write failed: " + filename };
+        }
+        return file_.size();
+      }
+    };
+
+    class PipeEncoder : public Recorder::Encoder
+    {
+      std::string command_;
+      double fps_;
+      std::FILE* pipe_;
+    public:
+      PipeEncoder(const std::string& command, double fps) :
+        command_{ command },
+        fps_{ fps },
+        pipe_{ nullptr }
+      {}
+
+      ~PipeEncoder() override
+      {
+        if (pipe_)
+        {
+          pclose(pipe_);
+        }
+      }
+
+      size_t write(const uint32_t* pixels, int w, int h, uint64_t) override
+      {
+        if (pipe_ == nullptr)
+        { // the command needs the size of the first frame
+          char number[32];
+          std::string command{ command_ };
+          replaceAll_(command, "{width}", std::to_string(w));
+          replaceAll_(command, "{height}", std::to_string(h));
+          std::snprintf(number, sizeof(number), "%g", fps_);
+          replaceAll_(command, "{fps}", number);
+          pipe_ = popen(command.c_str(), RECORDER_PIPE_MODE_);
+          if (pipe_ == nullptr)
+          {
+            throw std::runtime_error{ "Cannot start encoder: " + command };
+          }
+        }
+        const size_t size{ static_cast<size_t>(w) * static_cast<size_t>(h) * 4 };
+        writeAll_(pipe_, pixels, size);
+        return size;
+      }
+
+      void close() override
+      {
+        if (pipe_)
+        {
+          const int status{ pclose(pipe_) };
+          pipe_ = nullptr;
+          if (status != 0)
+          {
+            throw std::runtime_error{ "Encoder exited with status " + std::to_string(status) };
+          }
+        }
+      }
+    };
+  } // namespace
+
+  // Recorder ------------------------------------------------------------------
+
+  Recorder::Recorder() :
+    options_{},
+    recording_{ false },
+    frameCounter_{ 0 },
+    session_{},
+    width_{ 0 },
+    height_{ 0 },
+    mutex_{},
+    queueChanged_{},
+    queue_{},
+    pool_{},
+    stopping_{ false },
+    error_{},
+    encoder_{},
+    thread_{},
+    captured_{ 0 },
+    written_{ 0 },
+    dropped_{ 0 },
+    bytes_{ 0 }
+  {
+  }
+
+  Recorder::~Recorder()
+  {
+    stop();
+  }
+
+  void Recorder::start(const Options& options)
+  {
+    stop();
+
+    if (options.output.empty())
+    {
+      throw std::invalid_argument{ "Recorder: no output" };
+    }
+    if (options.everyNthFrame < 1 || options.queueSize < 1 || !(options.fps > 0.0))
+    {
+      throw std::invalid_argument{ "Recorder: invalid options" };
+    }
+    if (options.format == Format::Png && options.output.find("{frame}") == std::string::npos)
+    {
+      throw std::invalid_argument{ "Recorder: PNG output needs a {frame} placeholder" };
+    }
+
+    switch (options.format)
+    {
+    case Format::Y4M:
+      encoder_ = std::make_unique<Y4mEncoder>(options.output, options.fps);
+      break;
+    case Format::Png:
+      encoder_ = std::make_unique<PngEncoder>(options.output);
+      break;
+    case Format::Pipe:
+      encoder_ = std::make_unique<PipeEncoder>(options.output, options.fps);
+      break;
+    }
+
+    options_ = options;
+    frameCounter_ = 0;
+    width_ = 0;
+    height_ = 0;
+    session_ = std::make_shared<int>(0);
+    captured_ = 0;
+    written_ = 0;
+    dropped_ = 0;
+    bytes_ = 0;
+    {
+      std::lock_guard<std::mutex> lock{ mutex_ };
+      // One buffer per queued frame, plus the one being encoded
+      pool_.resize(options_.queueSize + 1);
+      stopping_ = false;
+      error_.clear();
+    }
+    thread_ = std::thread{ &Recorder::run_, this };
+    recording_ = true;
+  }
+
+  void Recorder::stop()
+  {
+    if (!recording_)
+    {
+      return;
+    }
+    recording_ = false;
+    session_.reset();
+    {
+      std::lock_guard<std::mutex> lock{ mutex_ };
+      stopping_ = true;
+    }
+    queueChanged_.notify_one();
+    thread_.join();
+    encoder_.reset();
+    pool_.clear();
+    pool_.shrink_to_fit();
+  }
+
+  Recorder::Stats Recorder::getStats() const
+  {
+    return Stats{ captured_.load(), written_.load(), dropped_.load(), bytes_.load() };
+  }
+
+  std::string Recorder::getError() const
+  {
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    return error_;
+  }
+
+  void Recorder::onFrame(Backend& backend)
+  {
+    if (!recording_ || frameCounter_++ % static_cast<uint64_t>(options_.everyNthFrame) != 0)
+    {
+      return;
+    }
+
+    const ImVec2 size{ ImGui::GetIO().DisplaySize };
+    const std::weak_ptr<int> session{ session_ };
+    const bool requested{ backend.CaptureFramebufferAsync(
+      0, 0, static_cast<int>(size.x), static_cast<int>(size.y),
+      [this, session](const unsigned int* pixels, int w, int h)
+      {
+        if (!session.expired())
+        {
+          capture_(pixels, w, h);
+        }
+      }) };
+    if (!requested)
+    {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void Recorder::capture_(const unsigned int* pixels, int w, int h)
+  {
+    captured_.fetch_add(1, std::memory_order_relaxed);
+    if (width_ == 0)
+    { // the first frame sets the size, even for the 4:2:0 chroma of Y4M
+      const bool even{ options_.format == Format::Y4M };
+      width_ = even ? w & ~1 : w;
+      height_ = even ? h & ~1 : h;
+    }
+
+    std::vector<uint32_t> buffer;
+    {
+      std::lock_guard<std::mutex> lock{ mutex_ };
+      if (pool_.empty() || !error_.empty() || width_ <= 0 || height_ <= 0)
+      { // the encoder is behind, or failed
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      buffer = std::move(pool_.back());
+      pool_.pop_back();
+    }
+
+    // Copy into the size of the recording, cropping or padding with black
+    const size_t width{ static_cast<size_t>(width_) };
+    const size_t copyWidth{ static_cast<size_t>(std::min(w, width_)) };
+    const int copyHeight{ std::min(h, height_) };
+    buffer.resize(width * static_cast<size_t>(height_));
+    for (int y = 0; y < copyHeight; ++y)
+    {
+      uint32_t* dst{ &buffer[static_cast<size_t>(y) * width] };
+      std::memcpy(dst, pixels + static_cast<size_t>(y) * static_cast<size_t>(w),
+        copyWidth * sizeof(uint32_t));
+      std::fill(dst + copyWidth, dst + width, IM_COL32_BLACK);
+    }
+    std::fill(buffer.begin() + static_cast<ptrdiff_t>(static_cast<size_t>(copyHeight) * width),
+      buffer.end(), IM_COL32_BLACK);
+
+    {
+      std::lock_guard<std::mutex> lock{ mutex_ };
+      queue_.push_back(Frame{ std::move(buffer), captured_.load(std::memory_order_relaxed) - 1 });
+    }
+    queueChanged_.notify_one();
+  }
+
+  void Recorder::run_()
+  {
+#ifdef RECORDER_POSIX_
+    // A pipe closed by the encoder must fail the write instead of killing
+    //  the process
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+#endif
+
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    for (;;)
+    {
+      queueChanged_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+      if (queue_.empty())
+      { // stopping, all frames encoded
+        break;
+      }
+      Frame frame{ std::move(queue_.front()) };
+      queue_.pop_front();
+      const bool failed{ !error_.empty() };
+      lock.unlock();
+
+      if (failed)
+      {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+      }
+      else
+      {
+        try
+        {
+          bytes_.fetch_add(encoder_->write(frame.pixels.data(), width_, height_, frame.index),
+            std::memory_order_relaxed);
+          written_.fetch_add(1, std::memory_order_relaxed);
+        }
+        catch (const std::exception& e)
+        {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          std::lock_guard<std::mutex> errorLock{ mutex_ };
+          error_ = e.what();
+        }
+      }
+
+      lock.lock();
+      pool_.push_back(std::move(frame.pixels));
+    }
+    lock.unlock();
+
+    try
+    {
+      encoder_->close();
+    }
+    catch (const std::exception& e)
+    {
+      std::lock_guard<std::mutex> errorLock{ mutex_ };
+      if (error_.empty())
+      {
+        error_ = e.what();
+      }
+    }
+  }
+
+} // namespace gui
@@ -3,6 +3,7 @@
 
 #include <gui/StackingSizer.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <numeric>
 #include <stdexcept>
@@ -11,10 +12,20 @@ namespace gui
 {
   StackingSizer::StackingSizer(Direction direction) :
     Sizer{},
-    direction_{direction}
+    direction_{direction},
+    weights_{},
+    layoutDirty_{ true },
+    layoutPos_{ 0, 0 },
+    layoutSize_{ 0, 0 },
+    layoutSpacing_{ 0, 0 }
   {
   }
 
+  void StackingSizer::addChild(Widget* child)
+  {
+    addChild(child, 1);
+  }
+
   void StackingSizer::addChild(Widget* child, int weight)
   {
     while (weights_.size() < getChildren().size())
@@ -27,6 +38,7 @@ namespace gui
     }
     Sizer::addChild(child);
     weights_.push_back(weight);
+    layoutDirty_ = true;
   }
 
   void StackingSizer::addWithFixedSize(Widget* child, int size)
@@ -35,6 +47,46 @@ namespace gui
     weights_.back() = -size; // negative size indicates fixed size
   }
 
+  void StackingSizer::removeChild(Widget* child)
+  {
+    // Remove the weights of the removed child so they stay aligned with the
+    //  remaining children
+    const auto& children{ getChildren() };
+    for (size_t i = children.size(); i-- > 0;)
+    {
+      if (children[i] == child && i < weights_.size())
+      {
+        weights_.erase(weights_.begin() + static_cast<std::ptrdiff_t>(i));
+      }
+    }
+    Sizer::removeChild(child);
+    layoutDirty_ = true;
+  }
+
+  void StackingSizer::setWeight(Widget* child, int weight)
+  {
+    if (weight == 0)
+    {
+      throw std::invalid_argument("weight cannot be 0");
+    }
+    const auto& children{ getChildren() };
+    const auto it{ std::find(children.begin(), children.end(), child) };
+    if (it == children.end())
+    {
+      throw std::invalid_argument("widget is not a child of this sizer");
+    }
+    const size_t index{ static_cast<size_t>(it - children.begin()) };
+    if (weights_.size() <= index)
+    {
+      weights_.resize(children.size(), 1);
+    }
+    if (weights_[index] != weight)
+    {
+      weights_[index] = weight;
+      layoutDirty_ = true;
+    }
+  }
+
   void StackingSizer::draw()
   {
     apply();
@@ -43,22 +95,36 @@ namespace gui
 
   void StackingSizer::apply()
   {
-    std::vector<Widget*> children{ getChildren() };
+    const std::vector<Widget*>& children{ getChildren() };
     const int numChildren{ static_cast<int>(children.size()) };
     if (numChildren == 0)
     { //no children, nothing to do
       return;
     }
     if (weights_.size() < numChildren)
-    {
+    { // children added through the base class interface
       weights_.resize(numChildren, 1);
+      layoutDirty_ = true;
     }
 
-    const bool isVertical{ direction_ == Direction::Vertical };
-
     const Vec2i totalSize{ getSize() };
     const Vec2i space{ getItemSpacing() };
 
+    // Reuse the last layout if nothing it depends on has changed
+    if (!layoutDirty_
+      && layoutPos_ == getPosition()
+      && layoutSize_ == totalSize
+      && layoutSpacing_ == space)
+    {
+      return;
+    }
+    layoutDirty_ = false;
+    layoutPos_ = getPosition();
+    layoutSize_ = totalSize;
+    layoutSpacing_ = space;
+
+    const bool isVertical{ direction_ == Direction::Vertical };
+
     // Size of weighted children
     // -------------------------
     // size = childSize + space + ... + childSize
@@ -100,7 +166,7 @@ namespace gui
     Vec2i pos{ getPosition() };
     for (int i = 0; i < numChildren; ++i)
     {
-      auto& child{ children[i] };
+      Widget* child{ children[i] };
       int weight{ weights_[i] };
       int size{ weight < 0 ? -weight : weight * childSize };
       if (i == lastWeightedIndex)
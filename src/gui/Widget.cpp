@@ -2,6 +2,7 @@
 //
 
 #include <gui/Widget.hpp>
+#include <gui/Profiler.hpp>
 
 #include "impl/util.hpp"
 
@@ -18,11 +19,19 @@ namespace gui
     const Vec2i& pos,
     const Vec2i& size) :
       Rect{pos, size},
-      name_{name}
+      name_{name},
+      serial_{ 0U },
+      id_{ 0U }
   {
     if (name_.empty())
+    { // the display name is formatted lazily in `getName()`
+      const util::Identifier identifier{ util::nextIdentifier() };
+      serial_ = identifier.serial;
+      id_ = identifier.id;
+    }
+    else
     {
-      name_ = util::generateIdentifier();
+      id_ = util::hashName(name_);
     }
   }
 
@@ -53,6 +62,10 @@ namespace gui
 
   const std::string& Widget::getName() const
   {
+    if (name_.empty())
+    {
+      name_ = util::formatIdentifier(serial_);
+    }
     return name_;
   }
 
@@ -63,6 +76,8 @@ namespace gui
       throw std::invalid_argument{"name cannot be empty"};
     }
     name_ = name;
+    serial_ = 0U;
+    id_ = util::hashName(name_);
   }
 
   void Widget::addChild(Widget* child)
@@ -79,6 +94,7 @@ namespace gui
 
   void Widget::draw()
   {
+    GUI_PROFILE_SCOPE_LABEL("Widget::draw", getName().c_str());
     if (renderBegin())
     {
       render();
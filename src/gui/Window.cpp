@@ -4,7 +4,9 @@
 #include <gui/Window.hpp>
 #include <gui/Frame.hpp>
 #include <gui/VerticalSizer.hpp>
-#include "impl/Backend.hpp"
+#include <gui/Profiler.hpp>
+#include <gui/Backend.hpp>
+#include "impl/DrawDataHash.hpp"
 
 #include <imgui.h>
 
@@ -22,6 +24,12 @@ namespace gui
     title_{title},
     size_{size},
     backend_{nullptr},
+    backendName_{},
+    vsync_{ VsyncMode::On },
+    skipUnchangedFrames_{ false },
+    lastDrawDataHash_{ 0 },
+    invalidated_{ true },
+    skippedFrames_{ 0 },
     sizer_{ std::make_unique<DefaultSizer>() },
     frames_{}
   {
@@ -59,10 +67,13 @@ namespace gui
     ImGui::StyleColorsLight();
 
     // Setup backend
-    backend_ = Backend::create();
+    if (!backend_)
+    {
+      backend_ = Backend::create(backendName_);
+    }
     backend_->DpiAware = true;
     backend_->SrgbFramebuffer = false;
-    backend_->Vsync = true;
+    setVsync(vsync_);
     backend_->ClearColor = ImVec4(0.120f, 0.120f, 0.120f, 1.000f);
     backend_->InitCreateWindow(title_.c_str(), size_.to<float>());
     backend_->InitBackends();
@@ -83,22 +94,55 @@ namespace gui
 
   bool Window::renderBegin()
   {
-    if (!backend_->NewFrame())
     {
-      return false;
+      GUI_PROFILE_SCOPE("Backend::NewFrame");
+      if (!backend_->NewFrame())
+      {
+        return false;
+      }
     }
 
     //Update size in case window was resized
     size_ = math::make<Vec2i>(ImGui::GetIO().DisplaySize);
 
+    GUI_PROFILE_SCOPE("ImGui::NewFrame");
     ImGui::NewFrame();
     return true;
   }
 
-  void Window::renderEnd()
+  bool Window::renderEnd()
   {
-    ImGui::Render();
+    {
+      GUI_PROFILE_SCOPE("ImGui::Render");
+      ImGui::Render();
+    }
+
+    if (skipUnchangedFrames_)
+    {
+      GUI_PROFILE_SCOPE("Window::hashDrawData");
+      const uint64_t hash{ util::hashDrawData(ImGui::GetDrawData()) };
+      const bool invalidated{ invalidated_.exchange(false) };
+      if (hash == lastDrawDataHash_ && !invalidated && !backend_->FramebufferLost)
+      { // same image as the one on screen
+        ++skippedFrames_;
+        return false;
+      }
+      lastDrawDataHash_ = hash;
+    }
+
+    GUI_PROFILE_SCOPE("Backend::Render");
     backend_->Render();
+    return true;
+  }
+
+  void Window::waitEvents(double timeout)
+  {
+    backend_->WaitEvents(timeout);
+  }
+
+  void Window::wakeUp()
+  {
+    backend_->PostWakeup();
   }
 
   void Window::render()
@@ -114,13 +158,26 @@ namespace gui
     {
       for (auto frame : frames_)
       {
-        frame->renderBegin();
-        frame->render();
-        frame->renderEnd();
+        frame->draw();
       }
     }
   }
 
+  void Window::setVsync(VsyncMode mode)
+  {
+    vsync_ = mode;
+    if (backend_)
+    {
+      backend_->SwapInterval =
+        mode == VsyncMode::Off ? 0 : (mode == VsyncMode::Adaptive ? -1 : 1);
+    }
+  }
+
+  void Window::setBackend(std::unique_ptr<Backend> backend)
+  {
+    backend_ = std::move(backend);
+  }
+
   void Window::addFrame(Frame* frame)
   {
     frames_.push_back(frame);
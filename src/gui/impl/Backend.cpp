@@ -1,22 +1,179 @@
-//  Copyright (c) 2024 Daniel Moreno. All rights reserved.
+//  Copyright (c) 2024-2025 Daniel Moreno. All rights reserved.
 //
-#include "Backend.hpp"
+#include <gui/Backend.hpp>
 
 #ifdef USE_GLFW_GL3
 # include "Backend_GLFW_GL3.hpp"
 #endif
-#include "Backend_Null.hpp"
+#include <gui/Backend_Null.hpp>
+#include "Backend_Software.hpp"
 
-namespace gui
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+
+namespace
 {
-  std::unique_ptr<Backend> Backend::create()
+  struct Registration
+  {
+    std::string name;
+    gui::Backend::Factory factory;
+    int priority;
+  };
+
+  // Parses a numeric environment variable, returns `defaultValue` if unset
+  double getEnvNumber_(const char* name, double defaultValue)
+  {
+    const char* value{ std::getenv(name) };
+    return value ? std::atof(value) : defaultValue;
+  }
+
+  // Applies the limits of headless backends from the environment
+  void configureHeadless_(gui::Backend_Null& backend)
   {
+    backend.Timeout = static_cast<float>(
+      getEnvNumber_("GUI_NULL_TIMEOUT", backend.Timeout));
+    backend.MaxFrames = static_cast<ImU64>(
+      getEnvNumber_("GUI_NULL_MAX_FRAMES", 0.0));
+  }
+
+  class Registry
+  {
+    std::mutex mutex_;
+    std::vector<Registration> registrations_;
+  public:
+    static Registry& getInstance()
+    {
+      static Registry instance;
+      return instance;
+    }
+
+    void add(const std::string& name, gui::Backend::Factory factory, int priority)
+    {
+      std::lock_guard<std::mutex> lock{ mutex_ };
+      auto it{ std::find_if(registrations_.begin(), registrations_.end(),
+        [&name](const Registration& r) { return r.name == name; }) };
+      if (it != registrations_.end())
+      {
+        registrations_.erase(it);
+      }
+      registrations_.push_back({ name, std::move(factory), priority });
+      // Keep the list sorted by priority, highest first
+      std::stable_sort(registrations_.begin(), registrations_.end(),
+        [](const Registration& a, const Registration& b)
+        {
+          return a.priority > b.priority;
+        });
+    }
+
+    gui::Backend::Factory find(const std::string& name)
+    {
+      std::lock_guard<std::mutex> lock{ mutex_ };
+      if (registrations_.empty())
+      {
+        return {};
+      }
+      if (name.empty())
+      {
+        return registrations_.front().factory;
+      }
+      for (const Registration& r : registrations_)
+      {
+        if (r.name == name)
+        {
+          return r.factory;
+        }
+      }
+      return {};
+    }
+
+    std::vector<std::string> getNames()
+    {
+      std::lock_guard<std::mutex> lock{ mutex_ };
+      std::vector<std::string> names;
+      for (const Registration& r : registrations_)
+      {
+        names.push_back(r.name);
+      }
+      return names;
+    }
+
+  private:
+    Registry()
+    {
+      // Built-in backends are registered here, rather than from their own
+      //  source files, so the linker cannot drop them from the static library
 #ifdef USE_GLFW_GL3
-    return Backend_GLFW_GL3::create();
+      add("glfw_gl3", []() -> std::unique_ptr<gui::Backend>
+        {
+          return gui::Backend_GLFW_GL3::create();
+        }, 100);
 #endif
 
-    // Dummy/Null Backend (last one in list so its only the default when there
-    //  are no other backends compiled in)
-    return Backend_Null::create();
+      // Dummy/Null Backend (lowest priority so its only the default when there
+      //  are no other backends compiled in). Its limits can be configured from
+      //  the environment for headless runs.
+      add("null", []() -> std::unique_ptr<gui::Backend>
+        {
+          auto backend{ gui::Backend_Null::create() };
+          configureHeadless_(*backend);
+          return backend;
+        }, 0);
+
+      // CPU rasterizer, only used when selected by name (e.g.
+      //  GUI_BACKEND=software). Same limits as the null backend.
+      add("software", []() -> std::unique_ptr<gui::Backend>
+        {
+          auto backend{ gui::Backend_Software::create() };
+          configureHeadless_(*backend);
+          backend->Threads = static_cast<int>(
+            getEnvNumber_("GUI_SOFTWARE_THREADS", 0.0));
+          return backend;
+        }, -10);
+    }
+  };
+}
+
+namespace gui
+{
+  std::unique_ptr<Backend> Backend::create(const std::string& name)
+  {
+    std::string selected{ name };
+    if (selected.empty())
+    {
+      if (const char* envName = std::getenv("GUI_BACKEND"))
+      {
+        selected = envName;
+      }
+    }
+
+    Factory factory{ Registry::getInstance().find(selected) };
+    if (!factory)
+    {
+      std::string available;
+      for (const std::string& n : getNames())
+      {
+        available += (available.empty() ? "" : ", ") + n;
+      }
+      throw std::runtime_error{
+        "Unknown GUI backend '" + selected + "' (available: " + available + ")" };
+    }
+    return factory();
+  }
+
+  void Backend::registerFactory(
+    const std::string& name, Factory factory, int priority)
+  {
+    if (name.empty() || !factory)
+    {
+      throw std::invalid_argument{ "backend name and factory are required" };
+    }
+    Registry::getInstance().add(name, std::move(factory), priority);
+  }
+
+  std::vector<std::string> Backend::getNames()
+  {
+    return Registry::getInstance().getNames();
   }
-}
\ No newline at end of file
+}
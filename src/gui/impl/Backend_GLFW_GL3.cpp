@@ -7,6 +7,9 @@
 # include <glad/gl.h>
 #endif
 
+#include <gl/Extensions.hpp>
+#include <gl/StateCache.hpp>
+
 #include <imgui_impl_opengl3.h>
 #include <imgui_impl_glfw.h>
 #include <GLFW/glfw3.h>
@@ -15,8 +18,11 @@
 # include <roboto_regular_webfont_ttf.hpp>
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <utility>
 
 #ifdef __linux__
 # include <unistd.h> // sleep
@@ -80,24 +86,31 @@ namespace
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
     glReadPixels(x, y2, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
-    // Flip vertically
-    size_t comp = 4;
-    size_t stride = static_cast<size_t>(w) * comp;
-    unsigned char* line_tmp = new unsigned char[stride];
-    unsigned char* line_a = reinterpret_cast<unsigned char*>(pixels);
-    unsigned char* line_b = line_a + (stride * (static_cast<size_t>(h) - 1));
+    // Flip vertically in place, swapping whole rows (vectorized)
+    const size_t stride = static_cast<size_t>(w);
+    unsigned int* line_a = pixels;
+    unsigned int* line_b = pixels + stride * (static_cast<size_t>(h) - 1);
     while (line_a < line_b)
     {
-      memcpy(line_tmp, line_a, stride);
-      memcpy(line_a, line_b, stride);
-      memcpy(line_b, line_tmp, stride);
+      std::swap_ranges(line_a, line_a + stride, line_b);
       line_a += stride;
       line_b -= stride;
     }
-    delete[] line_tmp;
     return true;
   }
 
+  // Longest wait for a capture fence when all the slots are in flight
+  constexpr GLuint64 kCaptureWaitNs{ 1000000000 };
+
+  // Set when the window contents need to be redrawn (e.g. the window was
+  //  uncovered), so frames are not skipped
+  bool windowRefreshed_{ true };
+
+  void RefreshCallback_(GLFWwindow*)
+  {
+    windowRefreshed_ = true;
+  }
+
   void ErrorCallback_(int error, const char* description)
   {
     fprintf(stderr, "Glfw Error %d: %s\n", error, description);
@@ -138,6 +151,10 @@ namespace gui
     // Create window with graphics context
     GLFWmonitor* primaryMonitor = glfwGetPrimaryMonitor();
     DpiScale = DpiAware ? GetDPI_(primaryMonitor) : 1.0f;
+    if (const GLFWvidmode* mode = glfwGetVideoMode(primaryMonitor))
+    {
+      RefreshRate = mode->refreshRate > 0 ? static_cast<float>(mode->refreshRate) : RefreshRate;
+    }
     window_size.x = std::floor(window_size.x * DpiScale);
     window_size.y = std::floor(window_size.y * DpiScale);
     window = glfwCreateWindow(
@@ -145,6 +162,7 @@ namespace gui
       window_title, nullptr, nullptr);
     if (window == nullptr)
       return false;
+    glfwSetWindowRefreshCallback(window, RefreshCallback_);
     glfwMakeContextCurrent(window);
 
   #ifdef USE_GLAD
@@ -159,6 +177,8 @@ namespace gui
       GLAD_VERSION_MAJOR(version),
       GLAD_VERSION_MINOR(version));
   #endif
+    // Entry points beyond the loaded GL version (e.g. sync objects)
+    gl::Extensions::load(glfwGetProcAddress);
 
     // Adjust scale
     ImGuiIO& io = ImGui::GetIO();
@@ -216,6 +236,10 @@ namespace gui
     glfwPollEvents();
     if (glfwWindowShouldClose(window))
       return false;
+    // The ImGui renderer and the captures bind with direct GL calls
+    gl::StateCache::getInstance().invalidate();
+    FramebufferLost = windowRefreshed_;
+    windowRefreshed_ = false;
     DpiScale = GetDPI_(window);
 #if !defined(IMGUI_IMPL_OPENGL_ES3) && !defined(IMGUI_IMPL_OPENGL_ES2)
     if (SrgbFramebuffer)
@@ -232,14 +256,39 @@ namespace gui
   {
     ImGuiIO& io = ImGui::GetIO();
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(Vsync ? 1 : 0);
+    if (SwapInterval != appliedSwapInterval_)
+    {
+      appliedSwapInterval_ = SwapInterval;
+      // Adaptive vsync (negative interval) needs the swap_control_tear
+      //  extension, fall back to regular vsync without it
+      const bool adaptive{ SwapInterval < 0
+        && (glfwExtensionSupported("WGL_EXT_swap_control_tear")
+          || glfwExtensionSupported("GLX_EXT_swap_control_tear")) };
+      glfwSwapInterval(adaptive ? -1 : (SwapInterval != 0 ? 1 : 0));
+    }
     glViewport(
       0, 0,
       static_cast<int>(io.DisplaySize.x), static_cast<int>(io.DisplaySize.y));
     glClearColor(ClearColor.x, ClearColor.y, ClearColor.z, ClearColor.w);
     glClear(GL_COLOR_BUFFER_BIT);
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    if (!captureRequests_.empty() || captureCount_ > 0)
+    {
+      processCaptures_();
+    }
     glfwSwapBuffers(window);
+    ++frame_;
+  }
+
+  void Backend_GLFW_GL3::WaitEvents(double timeout)
+  {
+    glfwWaitEventsTimeout(timeout);
+  }
+
+  void Backend_GLFW_GL3::PostWakeup()
+  {
+    // Thread-safe, wakes up glfwWaitEventsTimeout()
+    glfwPostEmptyEvent();
   }
 
   void Backend_GLFW_GL3::ShutdownCloseWindow()
@@ -250,6 +299,24 @@ namespace gui
 
   void Backend_GLFW_GL3::ShutdownBackends()
   {
+    // Pending captures are dropped
+    const gl::Extensions& ext{ gl::Extensions::get() };
+    for (CaptureSlot& slot : captureSlots_)
+    {
+      if (slot.Fence)
+      {
+        ext.DeleteSync(slot.Fence);
+      }
+      if (slot.Pbo)
+      {
+        glDeleteBuffers(1, &slot.Pbo);
+      }
+      slot = CaptureSlot{};
+    }
+    captureRequests_.clear();
+    captureHead_ = 0;
+    captureCount_ = 0;
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
   }
@@ -263,4 +330,133 @@ namespace gui
       viewport, x, y, w, h, pixels, user_data);
   }
 
+  bool Backend_GLFW_GL3::CaptureFramebufferAsync(
+    int x, int y, int w, int h, CaptureCallback callback)
+  {
+    if (x < 0 || y < 0 || w <= 0 || h <= 0 || !callback)
+    {
+      return false;
+    }
+    // A request for the same region before the next render shares its
+    //  readback, so repeated requests do not pile up
+    for (CaptureRequest& pending : captureRequests_)
+    {
+      if (pending.X == x && pending.Y == y && pending.W == w && pending.H == h)
+      {
+        pending.Callback = [first = std::move(pending.Callback), second = std::move(callback)](
+          const unsigned int* pixels_rgba, int width, int height)
+        {
+          first(pixels_rgba, width, height);
+          second(pixels_rgba, width, height);
+        };
+        return true;
+      }
+    }
+    captureRequests_.push_back(CaptureRequest{ x, y, w, h, std::move(callback) });
+    return true;
+  }
+
+  void Backend_GLFW_GL3::processCaptures_()
+  {
+    // Deliver the captures of previous frames that are ready
+    while (captureCount_ > 0 && resolveCapture_(captureSlots_[captureHead_], false))
+    {
+      captureHead_ = (captureHead_ + 1) % kCaptureSlots;
+      --captureCount_;
+    }
+
+    // Start reading the frame just rendered into a free PBO, the copy runs
+    //  asynchronously on the GPU. Callbacks may request new captures, which
+    //  are started by the next frame.
+    std::vector<CaptureRequest> requests;
+    requests.swap(captureRequests_);
+    const gl::Extensions& ext{ gl::Extensions::get() };
+    const int display_height{ static_cast<int>(ImGui::GetIO().DisplaySize.y) };
+    for (CaptureRequest& request : requests)
+    {
+      if (captureCount_ == kCaptureSlots)
+      { // all the slots are in flight, wait for the oldest
+        resolveCapture_(captureSlots_[captureHead_], true);
+        captureHead_ = (captureHead_ + 1) % kCaptureSlots;
+        --captureCount_;
+      }
+      CaptureSlot& slot{ captureSlots_[(captureHead_ + captureCount_) % kCaptureSlots] };
+      ++captureCount_;
+
+      if (slot.Pbo == 0)
+      {
+        glGenBuffers(1, &slot.Pbo);
+      }
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Pbo);
+      const size_t size{
+        static_cast<size_t>(request.W) * static_cast<size_t>(request.H) * sizeof(unsigned int) };
+      if (size > slot.Capacity)
+      {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        slot.Capacity = size;
+      }
+      glReadPixels(request.X, display_height - (request.Y + request.H), request.W, request.H,
+        GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+      slot.Fence = ext.hasSync() ? ext.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr;
+      slot.Frame = frame_;
+      slot.W = request.W;
+      slot.H = request.H;
+      slot.Callback = std::move(request.Callback);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    // Keep the allocation for the next captures
+    requests.clear();
+    if (captureRequests_.empty())
+    {
+      captureRequests_.swap(requests);
+    }
+  }
+
+  bool Backend_GLFW_GL3::resolveCapture_(CaptureSlot& slot, bool wait)
+  {
+    const gl::Extensions& ext{ gl::Extensions::get() };
+    if (slot.Fence)
+    {
+      const GLenum status{ ext.ClientWaitSync(slot.Fence,
+        wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? kCaptureWaitNs : 0) };
+      if (!wait && status == GL_TIMEOUT_EXPIRED)
+      {
+        return false;
+      }
+      ext.DeleteSync(slot.Fence);
+      slot.Fence = nullptr;
+    }
+    else if (!wait && frame_ < slot.Frame + kCaptureSlots - 1)
+    { // no sync objects, assume the copy is done a few frames later
+      return false;
+    }
+
+    // OpenGL rows are bottom-up, flip while copying out of the PBO
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Pbo);
+    const auto* mapped{ static_cast<const unsigned int*>(
+      glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY)) };
+    if (mapped)
+    {
+      const size_t stride{ static_cast<size_t>(slot.W) };
+      const size_t rows{ static_cast<size_t>(slot.H) };
+      capturePixels_.resize(stride * rows);
+      for (size_t row = 0; row < rows; ++row)
+      {
+        std::memcpy(&capturePixels_[row * stride], mapped + (rows - 1 - row) * stride,
+          stride * sizeof(unsigned int));
+      }
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    CaptureCallback callback{ std::move(slot.Callback) };
+    slot.Callback = nullptr;
+    if (mapped)
+    {
+      callback(capturePixels_.data(), slot.W, slot.H);
+    }
+    return true;
+  }
+
 } // namespace gui
@@ -3,10 +3,15 @@
 
 #pragma once
 
-#include "Backend.hpp"
+#include <gui/Backend.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
 
 // forward declaration
 struct GLFWwindow;
+struct __GLsync;
 
 namespace gui
 {
@@ -24,12 +29,51 @@ namespace gui
     void InitBackends() override;
     bool NewFrame() override;
     void Render() override;
+    void WaitEvents(double timeout) override;
+    void PostWakeup() override;
     void ShutdownCloseWindow() override;
     void ShutdownBackends() override;
     bool CaptureFramebuffer(
       ImGuiViewport* viewport,
       int x, int y, int w, int h,
       unsigned int* pixels_rgba, void* user_data) override;
+    bool CaptureFramebufferAsync(
+      int x, int y, int w, int h, CaptureCallback callback) override;
+
+  private:
+    // Pixel buffer objects in flight, a capture is read back when its fence
+    //  is signaled (or after `kCaptureSlots - 1` frames without sync objects)
+    static constexpr size_t kCaptureSlots{ 3 };
+
+    struct CaptureRequest
+    {
+      int X, Y, W, H;
+      CaptureCallback Callback;
+    };
+
+    struct CaptureSlot
+    {
+      unsigned Pbo = 0;
+      size_t Capacity = 0;        // bytes allocated in the PBO
+      __GLsync* Fence = nullptr;
+      uint64_t Frame = 0;
+      int W = 0, H = 0;
+      CaptureCallback Callback;
+    };
+
+    void processCaptures_();
+    bool resolveCapture_(CaptureSlot& slot, bool wait);
+
+    std::vector<CaptureRequest> captureRequests_;
+    std::array<CaptureSlot, kCaptureSlots> captureSlots_;
+    size_t captureHead_ = 0;      // oldest slot in flight
+    size_t captureCount_ = 0;     // slots in flight
+    std::vector<unsigned int> capturePixels_;
+    uint64_t frame_ = 0;
+
+    // Swap interval set in the GL context, it is only changed when
+    //  `SwapInterval` changes
+    int appliedSwapInterval_ = 2;
   };
 
 } // namespace gui
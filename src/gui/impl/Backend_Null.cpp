@@ -1,6 +1,7 @@
 //  Copyright (c) 2024 Daniel Moreno. All rights reserved.
 //
-#include "Backend_Null.hpp"
+#include <gui/Backend_Null.hpp>
+#include "DrawDataHash.hpp"
 
 #include <chrono>
 
@@ -63,14 +64,21 @@ namespace gui
     }
     LastTime = time;
 
-    // Decrement timeout
-    Timeout -= io.DeltaTime;
-    if (Timeout < 0)
+    // Check timeout
+    Elapsed += io.DeltaTime;
+    if (Timeout > 0.0f && Elapsed > Timeout)
     {
       printf("Backend_Null::Timeout\n");
       return false;
     }
 
+    // Check frame limit
+    if (MaxFrames > 0 && FrameCount >= MaxFrames)
+    {
+      return false;
+    }
+    ++FrameCount;
+
     return true;
   }
 
@@ -101,6 +109,56 @@ namespace gui
         }
       }
     }
+
+    if (CollectDrawStats)
+    {
+      collectDrawStats_(draw_data);
+    }
+  }
+
+  void Backend_Null::collectDrawStats_(const ImDrawData* draw_data)
+  {
+    DrawLists.clear();
+    DrawListsChanged = 0;
+    currentHashes_.clear();
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+      const ImDrawList* cmd_list = draw_data->CmdLists[n];
+      const uint64_t hash{ util::hashDrawList(cmd_list) };
+      const auto previous{ previousHashes_.find(cmd_list) };
+      const bool changed{ previous == previousHashes_.end() || previous->second != hash };
+      DrawLists.push_back(DrawListStats{ cmd_list,
+        cmd_list->VtxBuffer.Size, cmd_list->IdxBuffer.Size,
+        cmd_list->CmdBuffer.Size, hash, changed });
+      currentHashes_[cmd_list] = hash;
+
+      DrawListsChanged += changed ? 1 : 0;
+      TotalVertices += static_cast<ImU64>(cmd_list->VtxBuffer.Size);
+      TotalIndices += static_cast<ImU64>(cmd_list->IdxBuffer.Size);
+    }
+    TotalDrawLists += static_cast<ImU64>(draw_data->CmdListsCount);
+    TotalDrawListsChanged += static_cast<ImU64>(DrawListsChanged);
+
+    // Keep both maps allocated, `clear()` keeps the buckets
+    std::swap(previousHashes_, currentHashes_);
+  }
+
+  void Backend_Null::WaitEvents(double timeout)
+  {
+    // There are no input events, only wake ups
+    std::unique_lock<std::mutex> lock{ wakeupMutex_ };
+    wakeupCondition_.wait_for(lock, std::chrono::duration<double>(timeout),
+      [this]() { return wakeupPending_; });
+    wakeupPending_ = false;
+  }
+
+  void Backend_Null::PostWakeup()
+  {
+    {
+      std::lock_guard<std::mutex> lock{ wakeupMutex_ };
+      wakeupPending_ = true;
+    }
+    wakeupCondition_.notify_one();
   }
 
   void Backend_Null::ShutdownCloseWindow()
@@ -0,0 +1,613 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+#include "Backend_Software.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <type_traits>
+
+namespace
+{
+  // Largest supported tile, sizes the per-span buffers
+  constexpr int kMaxTileSize{ 256 };
+
+  template <typename T>
+  uint64_t toInteger_(T value)
+  {
+    if constexpr (std::is_pointer_v<T>)
+    {
+      return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+    }
+    else
+    {
+      return static_cast<uint64_t>(value);
+    }
+  }
+
+  inline float channel_(ImU32 color, int shift)
+  {
+    return static_cast<float>((color >> shift) & 0xFF) * (1.0f / 255.0f);
+  }
+
+  inline ImU32 pack_(float value, int shift)
+  {
+    const float clamped{ std::min(std::max(value, 0.0f), 1.0f) };
+    return static_cast<ImU32>(clamped * 255.0f + 0.5f) << shift;
+  }
+
+  // Blend with ImGui's blend mode: color = src * a + dst * (1 - a),
+  //  alpha = a + dst_a * (1 - a)
+  inline ImU32 blend_(ImU32 dst, float r, float g, float b, float a)
+  {
+    const float inv{ 1.0f - a };
+    return pack_(r * a + channel_(dst, IM_COL32_R_SHIFT) * inv, IM_COL32_R_SHIFT)
+      | pack_(g * a + channel_(dst, IM_COL32_G_SHIFT) * inv, IM_COL32_G_SHIFT)
+      | pack_(b * a + channel_(dst, IM_COL32_B_SHIFT) * inv, IM_COL32_B_SHIFT)
+      | pack_(a + channel_(dst, IM_COL32_A_SHIFT) * inv, IM_COL32_A_SHIFT);
+  }
+}
+
+namespace gui
+{
+  // Minimal thread pool, runs `job(i)` for every index of a range and waits
+  //  for completion. The calling thread takes part in the work.
+  class Backend_Software::Workers
+  {
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable startCondition_;
+    std::condition_variable doneCondition_;
+    const std::function<void(size_t)>* job_;
+    size_t count_;
+    std::atomic<size_t> next_;
+    uint64_t generation_;
+    size_t active_;
+    bool stop_;
+  public:
+    explicit Workers(size_t numThreads) :
+      threads_{},
+      job_{ nullptr },
+      count_{ 0 },
+      next_{ 0 },
+      generation_{ 0 },
+      active_{ 0 },
+      stop_{ false }
+    {
+      for (size_t i = 0; i < numThreads; ++i)
+      {
+        threads_.emplace_back([this]() { work_(); });
+      }
+    }
+
+    ~Workers()
+    {
+      {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        stop_ = true;
+      }
+      startCondition_.notify_all();
+      for (std::thread& thread : threads_)
+      {
+        thread.join();
+      }
+    }
+
+    void run(size_t count, const std::function<void(size_t)>& job)
+    {
+      {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        job_ = &job;
+        count_ = count;
+        next_.store(0);
+        active_ = threads_.size();
+        ++generation_;
+      }
+      startCondition_.notify_all();
+
+      runJobs_(job, count);
+
+      std::unique_lock<std::mutex> lock{ mutex_ };
+      doneCondition_.wait(lock, [this]() { return active_ == 0; });
+      job_ = nullptr;
+    }
+
+  private:
+    void runJobs_(const std::function<void(size_t)>& job, size_t count)
+    {
+      for (size_t i = next_.fetch_add(1); i < count; i = next_.fetch_add(1))
+      {
+        job(i);
+      }
+    }
+
+    void work_()
+    {
+      uint64_t generation{ 0 };
+      while (true)
+      {
+        const std::function<void(size_t)>* job;
+        size_t count;
+        {
+          std::unique_lock<std::mutex> lock{ mutex_ };
+          startCondition_.wait(lock,
+            [this, generation]() { return stop_ || generation_ != generation; });
+          if (stop_)
+          {
+            return;
+          }
+          generation = generation_;
+          job = job_;
+          count = count_;
+        }
+
+        runJobs_(*job, count);
+
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        if (--active_ == 0)
+        {
+          doneCondition_.notify_one();
+        }
+      }
+    }
+  };
+
+  Backend_Software::Backend_Software() = default;
+
+  Backend_Software::~Backend_Software() = default;
+
+  std::unique_ptr<Backend_Software> Backend_Software::create()
+  {
+    return std::make_unique<Backend_Software>();
+  }
+
+  bool Backend_Software::InitCreateWindow(
+    const char* window_title, ImVec2 window_size)
+  {
+    if (!Backend_Null::InitCreateWindow(window_title, window_size))
+    {
+      return false;
+    }
+
+    // Font atlas, sampled directly from the memory owned by ImGui
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* font_pixels = nullptr;
+    int font_width = 0;
+    int font_height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&font_pixels, &font_width, &font_height);
+    io.Fonts->SetTexID(RegisterTexture(
+      reinterpret_cast<const ImU32*>(font_pixels), font_width, font_height));
+    return true;
+  }
+
+  void Backend_Software::InitBackends()
+  {
+    Backend_Null::InitBackends();
+
+    const size_t numThreads{ Threads > 0
+      ? static_cast<size_t>(Threads)
+      : std::max<size_t>(1, std::thread::hardware_concurrency()) };
+    // The calling thread is one of the rasterizer threads
+    workers_ = std::make_unique<Workers>(numThreads - 1);
+  }
+
+  void Backend_Software::ShutdownBackends()
+  {
+    workers_.reset();
+    captureRequests_.clear();
+    Backend_Null::ShutdownBackends();
+  }
+
+  ImTextureID Backend_Software::RegisterTexture(
+    const ImU32* pixels, int width, int height)
+  {
+    const uint64_t id{ nextTextureId_++ };
+    textures_[id] = Texture{ pixels, width, height };
+    return (ImTextureID)(intptr_t)id;
+  }
+
+  void Backend_Software::UnregisterTexture(ImTextureID texture_id)
+  {
+    textures_.erase(toInteger_(texture_id));
+  }
+
+  void Backend_Software::Render()
+  {
+    // Callbacks and draw statistics
+    Backend_Null::Render();
+
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    const int width{ static_cast<int>(draw_data->DisplaySize.x * draw_data->FramebufferScale.x) };
+    const int height{ static_cast<int>(draw_data->DisplaySize.y * draw_data->FramebufferScale.y) };
+    if (width <= 0 || height <= 0)
+    {
+      return;
+    }
+
+    // Clear
+    if (width != width_ || height != height_)
+    {
+      width_ = width;
+      height_ = height;
+      pixels_.assign(static_cast<size_t>(width_) * static_cast<size_t>(height_), 0);
+    }
+    const ImU32 clear{
+      pack_(ClearColor.x, IM_COL32_R_SHIFT) | pack_(ClearColor.y, IM_COL32_G_SHIFT)
+      | pack_(ClearColor.z, IM_COL32_B_SHIFT) | pack_(ClearColor.w, IM_COL32_A_SHIFT) };
+    std::fill(pixels_.begin(), pixels_.end(), clear);
+
+    // Bin the triangles into tiles
+    tileSize_ = std::min(std::max(TileSize, 8), kMaxTileSize);
+    tilesX_ = (width_ + tileSize_ - 1) / tileSize_;
+    tilesY_ = (height_ + tileSize_ - 1) / tileSize_;
+    bins_.resize(static_cast<size_t>(tilesX_) * static_cast<size_t>(tilesY_));
+    for (auto& bin : bins_)
+    {
+      bin.clear();
+    }
+    setupTriangles_(draw_data);
+
+    // Rasterize the tiles in parallel
+    const std::function<void(size_t)> job{
+      [this](size_t tile_index) { rasterizeTile_(tile_index); } };
+    if (workers_)
+    {
+      workers_->run(bins_.size(), job);
+    }
+    else
+    {
+      for (size_t i = 0; i < bins_.size(); ++i)
+      {
+        job(i);
+      }
+    }
+
+    // The image is complete, serve the pending captures. Callbacks may
+    //  request new captures, which are served by the next frame.
+    servingRequests_.swap(captureRequests_);
+    for (CaptureRequest& request : servingRequests_)
+    {
+      capturePixels_.resize(static_cast<size_t>(request.W) * static_cast<size_t>(request.H));
+      if (CaptureFramebuffer(nullptr, request.X, request.Y, request.W, request.H,
+        capturePixels_.data(), nullptr))
+      {
+        request.Callback(capturePixels_.data(), request.W, request.H);
+      }
+    }
+    servingRequests_.clear();
+  }
+
+  void Backend_Software::setupTriangles_(const ImDrawData* draw_data)
+  {
+    triangles_.clear();
+    const ImVec2 clip_off = draw_data->DisplayPos;
+    const ImVec2 clip_scale = draw_data->FramebufferScale;
+
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+      const ImDrawList* cmd_list = draw_data->CmdLists[n];
+      const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data;
+      const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data;
+      for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+      {
+        const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+        if (pcmd->UserCallback != NULL)
+        { // already called by Backend_Null::Render()
+          continue;
+        }
+
+        // Scissor rectangle in framebuffer pixels, same rounding as the
+        //  OpenGL backend
+        const int clip_min_x{ std::max(0, static_cast<int>((pcmd->ClipRect.x - clip_off.x) * clip_scale.x)) };
+        const int clip_min_y{ std::max(0, static_cast<int>((pcmd->ClipRect.y - clip_off.y) * clip_scale.y)) };
+        const int clip_max_x{ std::min(width_, static_cast<int>((pcmd->ClipRect.z - clip_off.x) * clip_scale.x)) };
+        const int clip_max_y{ std::min(height_, static_cast<int>((pcmd->ClipRect.w - clip_off.y) * clip_scale.y)) };
+        if (clip_max_x <= clip_min_x || clip_max_y <= clip_min_y)
+        {
+          continue;
+        }
+
+        const auto texture_it{ textures_.find(toInteger_(pcmd->GetTexID())) };
+        const Texture* texture{
+          texture_it != textures_.end() ? &texture_it->second : nullptr };
+
+        for (unsigned int e = 0; e + 2 < pcmd->ElemCount; e += 3)
+        {
+          const ImDrawVert* v[3];
+          float x[3], y[3];
+          for (int k = 0; k < 3; ++k)
+          {
+            v[k] = &vtx_buffer[pcmd->VtxOffset + idx_buffer[pcmd->IdxOffset + e + k]];
+            x[k] = (v[k]->pos.x - clip_off.x) * clip_scale.x;
+            y[k] = (v[k]->pos.y - clip_off.y) * clip_scale.y;
+          }
+
+          Triangle tri;
+          // Bounding box of the pixel centers, clipped to the scissor
+          tri.MinX = std::max(clip_min_x, static_cast<int>(std::floor(std::min({ x[0], x[1], x[2] }))));
+          tri.MinY = std::max(clip_min_y, static_cast<int>(std::floor(std::min({ y[0], y[1], y[2] }))));
+          tri.MaxX = std::min(clip_max_x, static_cast<int>(std::ceil(std::max({ x[0], x[1], x[2] }))));
+          tri.MaxY = std::min(clip_max_y, static_cast<int>(std::ceil(std::max({ y[0], y[1], y[2] }))));
+          if (tri.MaxX <= tri.MinX || tri.MaxY <= tri.MinY)
+          {
+            continue;
+          }
+
+          // Edge k is opposite to vertex k:
+          //  E(a, b, p) = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x)
+          for (int k = 0; k < 3; ++k)
+          {
+            const int a{ (k + 1) % 3 };
+            const int b{ (k + 2) % 3 };
+            const float dx{ x[b] - x[a] };
+            const float dy{ y[b] - y[a] };
+            tri.A[k] = -dy;
+            tri.B[k] = dx;
+            tri.C[k] = dy * x[a] - dx * y[a];
+          }
+          float area{ tri.A[0] * x[0] + tri.B[0] * y[0] + tri.C[0] };
+          if (area == 0.0f)
+          {
+            continue;
+          }
+          if (area < 0.0f)
+          { // make the inside positive regardless of the winding
+            for (int k = 0; k < 3; ++k)
+            {
+              tri.A[k] = -tri.A[k];
+              tri.B[k] = -tri.B[k];
+              tri.C[k] = -tri.C[k];
+            }
+            area = -area;
+          }
+          for (int k = 0; k < 3; ++k)
+          { // top-left rule: pixels exactly on an edge belong to left and top edges
+            const bool top_left{ tri.A[k] > 0.0f || (tri.A[k] == 0.0f && tri.B[k] > 0.0f) };
+            tri.Threshold[k] = top_left ? -std::numeric_limits<float>::denorm_min() : 0.0f;
+          }
+
+          // Vertex attributes as planes: sum of value_k * E_k(p) / area
+          const float inv_area{ 1.0f / area };
+          const auto plane = [&tri, inv_area](const float value[3], float out[3])
+            {
+              out[0] = (value[0] * tri.A[0] + value[1] * tri.A[1] + value[2] * tri.A[2]) * inv_area;
+              out[1] = (value[0] * tri.B[0] + value[1] * tri.B[1] + value[2] * tri.B[2]) * inv_area;
+              out[2] = (value[0] * tri.C[0] + value[1] * tri.C[1] + value[2] * tri.C[2]) * inv_area;
+            };
+
+          // A texture sampled at a single texel (e.g. the white pixel of
+          //  the font atlas used by shapes) is folded into the colors
+          const bool same_uv{ v[0]->uv.x == v[1]->uv.x && v[0]->uv.x == v[2]->uv.x
+            && v[0]->uv.y == v[1]->uv.y && v[0]->uv.y == v[2]->uv.y };
+          float texel[4]{ 1.0f, 1.0f, 1.0f, 1.0f };
+          tri.Tex = texture;
+          if (texture && same_uv)
+          {
+            const int tx{ std::min(std::max(static_cast<int>(v[0]->uv.x * static_cast<float>(texture->Width)), 0), texture->Width - 1) };
+            const int ty{ std::min(std::max(static_cast<int>(v[0]->uv.y * static_cast<float>(texture->Height)), 0), texture->Height - 1) };
+            const ImU32 t{ texture->Pixels[static_cast<size_t>(ty) * static_cast<size_t>(texture->Width) + static_cast<size_t>(tx)] };
+            texel[0] = channel_(t, IM_COL32_R_SHIFT);
+            texel[1] = channel_(t, IM_COL32_G_SHIFT);
+            texel[2] = channel_(t, IM_COL32_B_SHIFT);
+            texel[3] = channel_(t, IM_COL32_A_SHIFT);
+            tri.Tex = nullptr;
+          }
+
+          static constexpr int kShifts[4]{
+            IM_COL32_R_SHIFT, IM_COL32_G_SHIFT, IM_COL32_B_SHIFT, IM_COL32_A_SHIFT };
+          for (int c = 0; c < 4; ++c)
+          {
+            const float value[3]{
+              channel_(v[0]->col, kShifts[c]) * texel[c],
+              channel_(v[1]->col, kShifts[c]) * texel[c],
+              channel_(v[2]->col, kShifts[c]) * texel[c] };
+            plane(value, tri.Color[c]);
+          }
+          tri.Solid = tri.Tex == nullptr
+            && v[0]->col == v[1]->col && v[0]->col == v[2]->col;
+          if (tri.Solid)
+          { // exact constant color, no interpolation error
+            for (int c = 0; c < 4; ++c)
+            {
+              tri.Color[c][0] = 0.0f;
+              tri.Color[c][1] = 0.0f;
+              tri.Color[c][2] = channel_(v[0]->col, kShifts[c]) * texel[c];
+            }
+            if (tri.Color[3][2] <= 0.0f)
+            { // fully transparent
+              continue;
+            }
+          }
+          if (tri.Tex)
+          {
+            const float u[3]{ v[0]->uv.x, v[1]->uv.x, v[2]->uv.x };
+            const float w[3]{ v[0]->uv.y, v[1]->uv.y, v[2]->uv.y };
+            plane(u, tri.U);
+            plane(w, tri.V);
+          }
+
+          // Add to the bins of the tiles it overlaps
+          const uint32_t index{ static_cast<uint32_t>(triangles_.size()) };
+          triangles_.push_back(tri);
+          const int tile_x0{ tri.MinX / tileSize_ };
+          const int tile_y0{ tri.MinY / tileSize_ };
+          const int tile_x1{ (tri.MaxX - 1) / tileSize_ };
+          const int tile_y1{ (tri.MaxY - 1) / tileSize_ };
+          for (int ty = tile_y0; ty <= tile_y1; ++ty)
+          {
+            for (int tx = tile_x0; tx <= tile_x1; ++tx)
+            {
+              bins_[static_cast<size_t>(ty * tilesX_ + tx)].push_back(index);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void Backend_Software::rasterizeTile_(size_t tile_index)
+  {
+    const int tile_x0{ static_cast<int>(tile_index % static_cast<size_t>(tilesX_)) * tileSize_ };
+    const int tile_y0{ static_cast<int>(tile_index / static_cast<size_t>(tilesX_)) * tileSize_ };
+    const int tile_x1{ std::min(tile_x0 + tileSize_, width_) };
+    const int tile_y1{ std::min(tile_y0 + tileSize_, height_) };
+
+    // Span buffers
+    alignas(32) float px[kMaxTileSize];
+    alignas(32) unsigned char inside[kMaxTileSize];
+
+    for (const uint32_t index : bins_[tile_index])
+    {
+      const Triangle& tri{ triangles_[index] };
+      const int x0{ std::max(tri.MinX, tile_x0) };
+      const int x1{ std::min(tri.MaxX, tile_x1) };
+      const int y0{ std::max(tri.MinY, tile_y0) };
+      const int y1{ std::min(tri.MaxY, tile_y1) };
+      const int n{ x1 - x0 };
+      if (n <= 0 || y1 <= y0)
+      {
+        continue;
+      }
+
+      for (int i = 0; i < n; ++i)
+      {
+        px[i] = static_cast<float>(x0 + i) + 0.5f;
+      }
+
+      for (int y = y0; y < y1; ++y)
+      {
+        const float py{ static_cast<float>(y) + 0.5f };
+        ImU32* row{ &pixels_[static_cast<size_t>(y) * static_cast<size_t>(width_) + static_cast<size_t>(x0)] };
+
+        // Coverage of the span, no dependencies between pixels so the loop
+        //  is vectorized
+        const float e0{ tri.B[0] * py + tri.C[0] };
+        const float e1{ tri.B[1] * py + tri.C[1] };
+        const float e2{ tri.B[2] * py + tri.C[2] };
+        unsigned char any{ 0 };
+        for (int i = 0; i < n; ++i)
+        {
+          const int in{ (tri.A[0] * px[i] + e0 > tri.Threshold[0])
+            & (tri.A[1] * px[i] + e1 > tri.Threshold[1])
+            & (tri.A[2] * px[i] + e2 > tri.Threshold[2]) };
+          inside[i] = static_cast<unsigned char>(in);
+          any |= inside[i];
+        }
+        if (!any)
+        {
+          continue;
+        }
+
+        if (tri.Solid)
+        {
+          const float r{ tri.Color[0][2] };
+          const float g{ tri.Color[1][2] };
+          const float b{ tri.Color[2][2] };
+          const float a{ tri.Color[3][2] };
+          for (int i = 0; i < n; ++i)
+          {
+            if (inside[i])
+            {
+              row[i] = blend_(row[i], r, g, b, a);
+            }
+          }
+          continue;
+        }
+
+        // Interpolated colors, and texture coordinates
+        const float r0{ tri.Color[0][1] * py + tri.Color[0][2] };
+        const float g0{ tri.Color[1][1] * py + tri.Color[1][2] };
+        const float b0{ tri.Color[2][1] * py + tri.Color[2][2] };
+        const float a0{ tri.Color[3][1] * py + tri.Color[3][2] };
+        const float u0{ tri.U[1] * py + tri.U[2] };
+        const float v0{ tri.V[1] * py + tri.V[2] };
+        for (int i = 0; i < n; ++i)
+        {
+          if (!inside[i])
+          {
+            continue;
+          }
+          float r{ tri.Color[0][0] * px[i] + r0 };
+          float g{ tri.Color[1][0] * px[i] + g0 };
+          float b{ tri.Color[2][0] * px[i] + b0 };
+          float a{ tri.Color[3][0] * px[i] + a0 };
+          if (tri.Tex)
+          {
+            const Texture& tex{ *tri.Tex };
+            const float u{ tri.U[0] * px[i] + u0 };
+            const float v{ tri.V[0] * px[i] + v0 };
+            const int tx{ std::min(std::max(static_cast<int>(u * static_cast<float>(tex.Width)), 0), tex.Width - 1) };
+            const int ty{ std::min(std::max(static_cast<int>(v * static_cast<float>(tex.Height)), 0), tex.Height - 1) };
+            const ImU32 t{ tex.Pixels[static_cast<size_t>(ty) * static_cast<size_t>(tex.Width) + static_cast<size_t>(tx)] };
+            r *= channel_(t, IM_COL32_R_SHIFT);
+            g *= channel_(t, IM_COL32_G_SHIFT);
+            b *= channel_(t, IM_COL32_B_SHIFT);
+            a *= channel_(t, IM_COL32_A_SHIFT);
+          }
+          a = std::min(std::max(a, 0.0f), 1.0f);
+          if (a > 0.0f)
+          {
+            row[i] = blend_(row[i], r, g, b, a);
+          }
+        }
+      }
+    }
+  }
+
+  bool Backend_Software::CaptureFramebuffer(
+    ImGuiViewport* viewport,
+    int x, int y, int w, int h,
+    unsigned int* pixels, void* user_data)
+  {
+    IM_UNUSED(viewport);
+    IM_UNUSED(user_data);
+    if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > width_ || y + h > height_)
+    {
+      return false;
+    }
+
+    // The framebuffer is already top row first
+    for (int row = 0; row < h; ++row)
+    {
+      std::memcpy(
+        pixels + static_cast<size_t>(row) * static_cast<size_t>(w),
+        &pixels_[static_cast<size_t>(y + row) * static_cast<size_t>(width_) + static_cast<size_t>(x)],
+        static_cast<size_t>(w) * sizeof(ImU32));
+    }
+    return true;
+  }
+
+  bool Backend_Software::CaptureFramebufferAsync(
+    int x, int y, int w, int h, CaptureCallback callback)
+  {
+    if (x < 0 || y < 0 || w <= 0 || h <= 0 || !callback)
+    {
+      return false;
+    }
+    // A request for the same region before the next render shares its
+    //  readback, so repeated requests do not pile up
+    for (CaptureRequest& pending : captureRequests_)
+    {
+      if (pending.X == x && pending.Y == y && pending.W == w && pending.H == h)
+      {
+        pending.Callback = [first = std::move(pending.Callback), second = std::move(callback)](
+          const unsigned int* pixels_rgba, int width, int height)
+        {
+          first(pixels_rgba, width, height);
+          second(pixels_rgba, width, height);
+        };
+        return true;
+      }
+    }
+    captureRequests_.push_back(CaptureRequest{ x, y, w, h, std::move(callback) });
+    return true;
+  }
+
+} // namespace gui
@@ -0,0 +1,109 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <gui/Backend_Null.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace gui
+{
+  // CPU rasterizer backend
+  // ----------------------
+  // Headless backend that renders `ImDrawData` into an in-memory RGBA buffer:
+  // textured triangles (nearest sampling) with scissor rectangles and alpha
+  // blending, including the font atlas. The framebuffer is split in tiles
+  // that are rasterized in parallel, each tile processing its triangles in
+  // submission order so the output is deterministic. Frame timing, limits and
+  // wake ups are the same as in `Backend_Null`.
+  class Backend_Software : public Backend_Null
+  {
+  public:
+    Backend_Software();
+    ~Backend_Software();
+
+    static std::unique_ptr<Backend_Software> create();
+
+    int     Threads = 0;    // [In]  InitBackends(): rasterizer threads, 0 for one per core
+    int     TileSize = 64;  // [In]  Render(): tile edge in pixels
+
+    bool InitCreateWindow(const char* window_title, ImVec2 window_size) override;
+    void InitBackends() override;
+    void Render() override;
+    void ShutdownBackends() override;
+    bool CaptureFramebuffer(
+      ImGuiViewport* viewport,
+      int x, int y, int w, int h,
+      unsigned int* pixels_rgba, void* user_data) override;
+    bool CaptureFramebufferAsync(
+      int x, int y, int w, int h, CaptureCallback callback) override;
+
+    // Last rendered image, RGBA8 (IM_COL32 layout), top row first
+    const std::vector<ImU32>& GetPixels() const { return pixels_; }
+    int GetWidth() const { return width_; }
+    int GetHeight() const { return height_; }
+
+    // Make an RGBA8 image available to `ImGui::Image()`. The pixels are not
+    //  copied and must stay valid until the texture is unregistered.
+    ImTextureID RegisterTexture(const ImU32* pixels, int width, int height);
+    void UnregisterTexture(ImTextureID texture_id);
+
+  private:
+    struct Texture
+    {
+      const ImU32* Pixels;
+      int Width;
+      int Height;
+    };
+
+    struct Triangle
+    {
+      // Edge functions `A * x + B * y + C`, positive inside
+      float A[3], B[3], C[3];
+      // Minimum edge value that is inside (top-left fill rule)
+      float Threshold[3];
+      // Attributes as planes over the screen: `value = dx * x + dy * y + c`
+      float U[3], V[3];
+      float Color[4][3];
+      bool Solid;             // uniform color and texel, no interpolation
+      const Texture* Tex;     // null for untextured (white) triangles
+      int MinX, MinY, MaxX, MaxY; // bounding box clipped to the scissor, exclusive max
+    };
+
+    struct CaptureRequest
+    {
+      int X, Y, W, H;
+      CaptureCallback Callback;
+    };
+
+    class Workers;
+
+    void setupTriangles_(const ImDrawData* draw_data);
+    void rasterizeTile_(size_t tile_index);
+
+    std::vector<ImU32> pixels_;
+    int width_ = 0;
+    int height_ = 0;
+
+    uint64_t nextTextureId_ = 1;
+    std::unordered_map<uint64_t, Texture> textures_;
+
+    std::vector<Triangle> triangles_;
+    std::vector<std::vector<uint32_t>> bins_;
+    int tilesX_ = 0;
+    int tilesY_ = 0;
+    int tileSize_ = 64;
+
+    std::unique_ptr<Workers> workers_;
+
+    // Served at the end of the next `Render()`
+    std::vector<CaptureRequest> captureRequests_;
+    std::vector<CaptureRequest> servingRequests_;
+    std::vector<unsigned int> capturePixels_;
+  };
+
+} // namespace gui
@@ -0,0 +1,132 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include "DrawDataHash.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+namespace gui::util
+{
+  namespace
+  {
+    constexpr uint64_t kPrime1{ 0x9E3779B185EBCA87ULL };
+    constexpr uint64_t kPrime2{ 0xC2B2AE3D27D4EB4FULL };
+    constexpr uint64_t kPrime3{ 0x165667B19E3779F9ULL };
+
+    inline uint64_t rotl_(uint64_t x, int r)
+    {
+      return (x << r) | (x >> (64 - r));
+    }
+
+    inline uint64_t round_(uint64_t acc, uint64_t input)
+    {
+      acc += input * kPrime2;
+      acc = rotl_(acc, 31);
+      return acc * kPrime1;
+    }
+
+    inline uint64_t mix_(uint64_t h)
+    {
+      h ^= h >> 33;
+      h *= kPrime2;
+      h ^= h >> 29;
+      h *= kPrime3;
+      h ^= h >> 32;
+      return h;
+    }
+
+    inline uint64_t combine_(uint64_t seed, uint64_t value)
+    {
+      return mix_(seed ^ (value + kPrime1 + (seed << 6) + (seed >> 2)));
+    }
+
+    template <typename T>
+    uint64_t toInteger_(T value)
+    {
+      if constexpr (std::is_pointer_v<T>)
+      {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+      }
+      else
+      {
+        return static_cast<uint64_t>(value);
+      }
+    }
+  } // namespace
+
+  uint64_t hashBytes(const void* data, size_t size, uint64_t seed)
+  {
+    const unsigned char* bytes{ static_cast<const unsigned char*>(data) };
+    uint64_t lanes[4]{
+      seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1 };
+
+    // 32-byte stripes, one 8-byte word per lane
+    size_t offset{ 0 };
+    for (; offset + 32 <= size; offset += 32)
+    {
+      uint64_t words[4];
+      std::memcpy(words, bytes + offset, sizeof(words));
+      for (int lane = 0; lane < 4; ++lane)
+      {
+        lanes[lane] = round_(lanes[lane], words[lane]);
+      }
+    }
+
+    uint64_t h{ rotl_(lanes[0], 1) + rotl_(lanes[1], 7)
+      + rotl_(lanes[2], 12) + rotl_(lanes[3], 18) };
+    h += static_cast<uint64_t>(size);
+
+    // Remaining words and bytes
+    for (; offset + 8 <= size; offset += 8)
+    {
+      uint64_t word;
+      std::memcpy(&word, bytes + offset, sizeof(word));
+      h = rotl_(h ^ round_(0, word), 27) * kPrime1 + kPrime3;
+    }
+    for (; offset < size; ++offset)
+    {
+      h = rotl_(h ^ (bytes[offset] * kPrime3), 11) * kPrime1;
+    }
+    return mix_(h);
+  }
+
+  uint64_t hashDrawList(const ImDrawList* drawList)
+  {
+    uint64_t h{ hashBytes(drawList->VtxBuffer.Data,
+      static_cast<size_t>(drawList->VtxBuffer.Size) * sizeof(ImDrawVert)) };
+    h = hashBytes(drawList->IdxBuffer.Data,
+      static_cast<size_t>(drawList->IdxBuffer.Size) * sizeof(ImDrawIdx), h);
+
+    // Hash the command fields one by one, the struct may contain padding
+    for (const ImDrawCmd& cmd : drawList->CmdBuffer)
+    {
+      h = hashBytes(&cmd.ClipRect, sizeof(cmd.ClipRect), h);
+      h = combine_(h, toInteger_(cmd.GetTexID()));
+      h = combine_(h, (static_cast<uint64_t>(cmd.VtxOffset) << 32) | cmd.IdxOffset);
+      h = combine_(h, cmd.ElemCount);
+      h = combine_(h, toInteger_(cmd.UserCallback));
+      h = combine_(h, toInteger_(cmd.UserCallbackData));
+    }
+    return h;
+  }
+
+  uint64_t hashDrawData(const ImDrawData* drawData)
+  {
+    if (drawData == nullptr || !drawData->Valid)
+    {
+      return 0;
+    }
+
+    const float display[6]{
+      drawData->DisplayPos.x, drawData->DisplayPos.y,
+      drawData->DisplaySize.x, drawData->DisplaySize.y,
+      drawData->FramebufferScale.x, drawData->FramebufferScale.y };
+    uint64_t h{ hashBytes(display, sizeof(display)) };
+    for (int n = 0; n < drawData->CmdListsCount; ++n)
+    {
+      h = combine_(h, hashDrawList(drawData->CmdLists[n]));
+    }
+    return h;
+  }
+}
@@ -0,0 +1,34 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <imgui.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gui::util
+{
+  //! Hashes a block of memory.
+  //! \param data The bytes to hash.
+  //! \param size The number of bytes.
+  //! \param seed The initial value, e.g. the hash of the previous block.
+  //! \return A 64-bit hash, not suitable for cryptographic use.
+  //! \note The input is processed as four independent 64-bit lanes, so the
+  //!       main loop has no dependency between lanes and the compiler can
+  //!       vectorize it.
+  uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+  //! Hashes the geometry and commands of a draw list.
+  //! \param drawList The draw list to hash.
+  //! \return A hash of the vertices, indices and draw commands (clip
+  //!         rectangles, textures, offsets, element counts and callbacks).
+  uint64_t hashDrawList(const ImDrawList* drawList);
+
+  //! Hashes all the draw lists and the display rectangle of a frame.
+  //! \param drawData The draw data of the frame, may be null.
+  //! \return A hash that is equal for frames that render the same image,
+  //!         except for the content drawn by user callbacks.
+  uint64_t hashDrawData(const ImDrawData* drawData);
+}
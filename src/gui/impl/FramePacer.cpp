@@ -0,0 +1,137 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include "FramePacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace gui
+{
+  // Number of frame intervals kept for statistics
+  static constexpr size_t kStatsFrames{ 240 };
+
+  // Overshoot assumed before the first sleep is measured, on the safe side of
+  //  common scheduler granularities
+  static constexpr double kInitialOvershoot{ 2e-3 };
+
+  FramePacer::FramePacer() :
+    targetFps_{ 0.0 },
+    period_{ Clock::duration::zero() },
+    deadline_{},
+    lastFrame_{},
+    overshootMean_{ kInitialOvershoot },
+    overshootM2_{ 0.0 },
+    overshootCount_{ 1 },
+    intervalsMs_{},
+    nextInterval_{ 0 },
+    frames_{ 0 }
+  {
+    intervalsMs_.reserve(kStatsFrames);
+  }
+
+  void FramePacer::setTargetFps(double fps)
+  {
+    targetFps_ = std::max(fps, 0.0);
+    period_ = targetFps_ > 0.0
+      ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps_))
+      : Clock::duration::zero();
+    deadline_ = Clock::time_point{};
+  }
+
+  void FramePacer::endFrame()
+  {
+    if (period_ > Clock::duration::zero())
+    {
+      const Clock::time_point now{ Clock::now() };
+      if (deadline_ == Clock::time_point{} || now - deadline_ > period_)
+      { // first frame, or more than one frame late: restart the phase
+        deadline_ = now + period_;
+      }
+      else
+      {
+        deadline_ += period_;
+      }
+      sleepUntil_(deadline_);
+    }
+
+    const Clock::time_point now{ Clock::now() };
+    if (lastFrame_ != Clock::time_point{})
+    {
+      const double intervalMs{
+        std::chrono::duration<double, std::milli>(now - lastFrame_).count() };
+      if (intervalsMs_.size() < kStatsFrames)
+      {
+        intervalsMs_.push_back(intervalMs);
+      }
+      else
+      {
+        intervalsMs_[nextInterval_] = intervalMs;
+      }
+      nextInterval_ = (nextInterval_ + 1) % kStatsFrames;
+    }
+    lastFrame_ = now;
+    ++frames_;
+  }
+
+  void FramePacer::reset()
+  {
+    deadline_ = Clock::time_point{};
+    lastFrame_ = Clock::time_point{};
+  }
+
+  void FramePacer::sleepUntil_(Clock::time_point deadline)
+  {
+    // Sleep until the deadline minus a pessimistic estimate of the overshoot
+    //  (mean + 2 sigma), and measure the overshoot of that sleep
+    const double estimate{ overshootMean_
+      + 2.0 * std::sqrt(overshootM2_ / static_cast<double>(overshootCount_)) };
+    const Clock::time_point wakeUp{ deadline
+      - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(estimate)) };
+    if (Clock::now() < wakeUp)
+    {
+      std::this_thread::sleep_until(wakeUp);
+      const double overshoot{
+        std::chrono::duration<double>(Clock::now() - wakeUp).count() };
+
+      ++overshootCount_;
+      const double delta{ overshoot - overshootMean_ };
+      overshootMean_ += delta / static_cast<double>(overshootCount_);
+      overshootM2_ += delta * (overshoot - overshootMean_);
+    }
+
+    // Spin for the rest
+    while (Clock::now() < deadline)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  Application::FrameStats FramePacer::getStats() const
+  {
+    Application::FrameStats stats{};
+    stats.frames = frames_;
+    if (intervalsMs_.empty())
+    {
+      return stats;
+    }
+
+    std::vector<double> sorted{ intervalsMs_ };
+    std::sort(sorted.begin(), sorted.end());
+    double total{ 0.0 };
+    for (double interval : sorted)
+    {
+      total += interval;
+    }
+    const size_t count{ sorted.size() };
+    stats.meanMs = total / static_cast<double>(count);
+    stats.minMs = sorted.front();
+    stats.maxMs = sorted.back();
+    stats.p50Ms = sorted[count / 2];
+    stats.p99Ms = sorted[std::min(count - 1, count * 99 / 100)];
+    stats.fps = stats.meanMs > 0.0 ? 1000.0 / stats.meanMs : 0.0;
+    return stats;
+  }
+
+} // namespace gui
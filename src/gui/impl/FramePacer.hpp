@@ -0,0 +1,58 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <gui/Application.hpp>
+
+#include <chrono>
+#include <vector>
+
+namespace gui
+{
+  // Frame pacing
+  // ------------
+  // Waits until the next frame deadline of the target frame rate. Deadlines
+  // are absolute (one period after the previous one), so the frame rate does
+  // not drift. The wait sleeps once until the deadline minus the estimated
+  // sleep overshoot (measured on every sleep), then spins for the rest, which
+  // is precise even where the OS scheduler granularity is coarse. Also keeps
+  // the achieved frame intervals for statistics.
+  class FramePacer
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    FramePacer();
+
+    // Target frame rate, 0 for uncapped
+    void setTargetFps(double fps);
+    double getTargetFps() const { return targetFps_; }
+
+    // Wait for the next frame deadline and record the frame interval
+    void endFrame();
+
+    // Forget the last deadline and frame (e.g. after waiting for events)
+    void reset();
+
+    Application::FrameStats getStats() const;
+
+  private:
+    void sleepUntil_(Clock::time_point deadline);
+
+    double targetFps_;
+    Clock::duration period_;
+    Clock::time_point deadline_;
+    Clock::time_point lastFrame_;
+    // Estimated sleep overshoot in seconds (mean and variance, Welford's
+    //  algorithm)
+    double overshootMean_;
+    double overshootM2_;
+    uint64_t overshootCount_;
+    // Ring of the last frame intervals, in milliseconds
+    std::vector<double> intervalsMs_;
+    size_t nextInterval_;
+    uint64_t frames_;
+  };
+
+} // namespace gui
@@ -0,0 +1,117 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace gui
+{
+  // Lock-free multiple-producer single-consumer task queue
+  // -----------------------------------------------------
+  // Intrusive node-based queue (D. Vyukov). `push()` can be called from any
+  // thread and never blocks, `pop()` must only be called from one thread
+  // (the GUI thread). A `pop()` may return false while a concurrent `push()`
+  // is being linked, the task is then returned by a later `pop()`.
+  class TaskQueue
+  {
+  public:
+    using Task = std::function<void()>;
+
+    TaskQueue() : stub_{}, head_{ &stub_ }, tail_{ &stub_ }, size_{ 0 }
+    {
+    }
+
+    ~TaskQueue()
+    {
+      // Pending tasks are dropped
+      Task task;
+      while (pop(task))
+      {
+      }
+    }
+
+    TaskQueue(const TaskQueue&) = delete;
+    TaskQueue& operator=(const TaskQueue&) = delete;
+
+    // Producer side, thread-safe
+    void push(Task task)
+    {
+      // Counted before linking, so `size()` never underflows
+      size_.fetch_add(1, std::memory_order_relaxed);
+      push_(new Node{ std::move(task) });
+    }
+
+    // Tasks pushed and not popped yet, some may still be being linked
+    size_t size() const
+    {
+      return size_.load(std::memory_order_relaxed);
+    }
+
+    // Consumer side, single thread only
+    bool pop(Task& task)
+    {
+      Node* tail{ tail_ };
+      Node* next{ tail->next.load(std::memory_order_acquire) };
+      if (tail == &stub_)
+      { // skip the stub node
+        if (next == nullptr)
+        {
+          return false;
+        }
+        tail_ = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+      }
+      if (next != nullptr)
+      {
+        tail_ = next;
+        task = std::move(tail->task);
+        delete tail;
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+      if (tail != head_.load(std::memory_order_acquire))
+      { // a producer is linking a new node
+        return false;
+      }
+      // Last node: re-insert the stub so the last node can be released
+      push_(&stub_);
+      next = tail->next.load(std::memory_order_acquire);
+      if (next != nullptr)
+      {
+        tail_ = next;
+        task = std::move(tail->task);
+        delete tail;
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+      return false;
+    }
+
+  private:
+    struct Node
+    {
+      Node() = default;
+      explicit Node(Task t) : task{ std::move(t) } {}
+      std::atomic<Node*> next{ nullptr };
+      Task task;
+    };
+
+    void push_(Node* node)
+    {
+      node->next.store(nullptr, std::memory_order_relaxed);
+      Node* prev{ head_.exchange(node, std::memory_order_acq_rel) };
+      prev->next.store(node, std::memory_order_release);
+    }
+
+    Node stub_;
+    std::atomic<Node*> head_;
+    Node* tail_;
+    std::atomic<size_t> size_;
+  };
+
+} // namespace gui
@@ -3,27 +3,40 @@
 
 #include "util.hpp"
 
-#include <cstdlib>
+#include <imgui_internal.h> // For ImHashData, ImHashStr
+
+#include <atomic>
 
 namespace gui::util
 {
-  std::string generateIdentifier(uint64_t seed, size_t length)
+  namespace
   {
-    const char alphanum[] =
-        "0123456789"
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-        "abcdefghijklmnopqrstuvwxyz";
-
-    std::string result;
-    if (seed != 0U)
-    {
-      std::srand(seed);
-    }
+    std::atomic<uint64_t> nextSerial_{ 1U };
+  }
 
-    for (size_t i = 0; i < length; ++i) {
-        result += alphanum[std::rand() % (sizeof(alphanum) - 1)];
+  Identifier nextIdentifier()
+  {
+    const uint64_t serial{ nextSerial_.fetch_add(1U, std::memory_order_relaxed) };
+    ImGuiID id{ ImHashData(&serial, sizeof(serial), 0U) };
+    if (id == 0U)
+    { // 0 is not a valid ImGui identifier
+      id = 1U;
     }
+    return { serial, id };
+  }
+
+  std::string formatIdentifier(uint64_t serial)
+  {
+    return "Widget_" + std::to_string(serial);
+  }
+
+  ImGuiID hashName(std::string_view name)
+  {
+    return ImHashStr(name.data(), name.size(), 0U);
+  }
 
-    return result;
+  std::string generateIdentifier()
+  {
+    return formatIdentifier(nextIdentifier().serial);
   }
 }
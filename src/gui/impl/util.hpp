@@ -1,23 +1,42 @@
-//  Copyright (c) 2024 Daniel Moreno. All rights reserved.
+//  Copyright (c) 2024-2025 Daniel Moreno. All rights reserved.
 //
 
+#pragma once
+
+#include <imgui.h>
+
 #include <string>
+#include <string_view>
 #include <cstdint> // For uint64_t
 
 namespace gui::util
 {
-  //! Generates a random identifier string.
-  //! \param seed The seed for the random number generator. If 0, the seed is
-  //!             not set. It defaults to 0.
-  //! \param length The length of the identifier string. It defaults to 4.
-  //! \return A random identifier string.
-  //! \note The identifier string is generated using alphanumeric characters.
-  //!
-  //! If a `seed == 0` is desired, then it must be set prior to calling this
-  //! function, like this:
-  //! \code{.cpp}
-  //!   std::srand(0);
-  //! \endcode
-  //!
-  std::string generateIdentifier(uint64_t seed = 0U, size_t length = 4U);
+  //! Process-wide unique identifier.
+  struct Identifier
+  {
+    uint64_t serial;  //!< Monotonic serial number, never 0 and never reused
+    ImGuiID id;       //!< Pre-hashed ImGui identifier of `serial`
+  };
+
+  //! Allocates a new identifier.
+  //! \return An identifier that is unique within the process.
+  //! \note This function is lock-free and thread-safe. Serial numbers start
+  //!       at 1 and increase with each call, so a program that creates its
+  //!       widgets in the same order gets the same identifiers on every run.
+  Identifier nextIdentifier();
+
+  //! Formats the display name of an identifier serial number.
+  //! \param serial The serial number returned by `nextIdentifier()`.
+  //! \return The display name, e.g. "Widget_12".
+  std::string formatIdentifier(uint64_t serial);
+
+  //! Computes the ImGui identifier of a name.
+  //! \param name The name to hash.
+  //! \return The ImGui identifier, the same as hashing `name` at the root of
+  //!         the ImGui ID stack.
+  ImGuiID hashName(std::string_view name);
+
+  //! Generates a unique identifier string.
+  //! \return The display name of a newly allocated identifier.
+  std::string generateIdentifier();
 }
@@ -17,7 +17,27 @@ namespace timer
 
   void Timer::start(size_t milliseconds, Callback callback)
   {
-    impl_->start(milliseconds, std::move(callback));
+    impl_->start(std::chrono::milliseconds(milliseconds), std::move(callback));
+  }
+
+  void Timer::start(std::chrono::microseconds period, Callback callback)
+  {
+    impl_->start(period, std::move(callback));
+  }
+
+  void Timer::startOnce(std::chrono::microseconds delay, Callback callback)
+  {
+    impl_->startOnce(delay, std::move(callback));
+  }
+
+  void Timer::debounce(std::chrono::microseconds delay, Callback callback)
+  {
+    impl_->startOnce(delay, std::move(callback));
+  }
+
+  void Timer::throttle(std::chrono::microseconds interval, Callback callback)
+  {
+    impl_->throttle(interval, std::move(callback));
   }
 
   void Timer::stop()
@@ -25,9 +45,29 @@ namespace timer
     impl_->stop();
   }
 
+  void Timer::cancel()
+  {
+    impl_->cancel();
+  }
+
   bool Timer::isRunning() const
   {
     return impl_->isRunning();
   }
 
+  void Timer::setOverrunPolicy(OverrunPolicy policy)
+  {
+    impl_->setOverrunPolicy(policy);
+  }
+
+  Timer::Stats Timer::getStats() const
+  {
+    return impl_->getStats();
+  }
+
+  void Timer::setExecutor(Executor executor)
+  {
+    impl_->setExecutor(std::move(executor));
+  }
+
 } // namespace timer
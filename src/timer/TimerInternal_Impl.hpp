@@ -5,21 +5,37 @@
 
 #include <timer/Timer.hpp>
 
+#include "TimerService.hpp"
+
+#include <algorithm>
 #include <chrono>
 #include <atomic>
-#include <thread>
-
-#include <iostream>
+#include <memory>
+#include <mutex>
 
 namespace timer
 {
   class Timer::Impl
   {
-    std::atomic<bool> running_;
-    std::thread thread_;
+    TimerService& service_;
+    // Id of the scheduled callback in the service, 0 when stopped
+    std::atomic<TimerService::Id> id_;
+    Executor executor_;
+    OverrunPolicy policy_;
+    std::shared_ptr<TimerService::Counters> counters_;
+    // Cleared on stop, so callbacks still queued in the executor are skipped
+    std::shared_ptr<std::atomic<bool>> alive_;
+    // Throttle mode state
+    std::mutex throttleMutex_;
+    Callback throttled_;
+    bool throttlePending_;
+    TimerService::Clock::time_point lastThrottled_;
   public:
     // Default constructor
-    Impl() : running_{false}, thread_{}
+    Impl() : service_{ TimerService::getInstance() }, id_{ 0 }, executor_{},
+      policy_{ OverrunPolicy::Skip },
+      counters_{ std::make_shared<TimerService::Counters>() }, alive_{},
+      throttleMutex_{}, throttled_{}, throttlePending_{ false }, lastThrottled_{}
     {
     }
 
@@ -30,70 +46,154 @@ namespace timer
     }
 
     // Start the timer
-    void start(size_t milliseconds, Callback callback)
+    void start(std::chrono::microseconds period, Callback callback)
     {
-      // Ensure the timer is stopped before starting a new one, and old thread
-      // is joined if it wasn't already
-      stop();
-
-      if (running_ || thread_.joinable())
-      { // The timer thread is still running, something is wrong
-        throw std::runtime_error{ "Timer thread is still running" };
+      if (period <= std::chrono::microseconds::zero())
+      { // Do not start the timer if the period is zero
+        stop();
         return;
       }
+      schedule_(period, true, std::move(callback));
+    }
 
-      if (milliseconds == 0)
-      { // Do not start the timer if the period is zero
+    // Start a one-shot timer
+    void startOnce(std::chrono::microseconds delay, Callback callback)
+    {
+      schedule_(std::max(delay, std::chrono::microseconds::zero()), false,
+        std::move(callback));
+    }
+
+    // Call the latest callback at most once per interval
+    void throttle(std::chrono::microseconds interval, Callback callback)
+    {
+      std::unique_lock<std::mutex> lock{ throttleMutex_ };
+      throttled_ = std::move(callback);
+      if (throttlePending_)
+      { // the pending call will run the latest callback
         return;
       }
+      throttlePending_ = true;
+      const auto delay{ std::chrono::duration_cast<std::chrono::microseconds>(
+        lastThrottled_ + interval - TimerService::Clock::now()) };
+      lock.unlock();
 
-      // Start a new timer
-      running_ = true;
-      thread_ = std::thread(
-        [this, milliseconds, callback = std::move(callback)]()
+      startOnce(delay, [this]()
         {
-          // Calculate the time taken by the callback function last time
-          std::chrono::milliseconds callbackTime{ 0 };
-          while (running_)
+          Callback callback;
           {
-            // Sleep until the next callback event
-            if (callbackTime < std::chrono::milliseconds(milliseconds))
-            {
-              std::this_thread::sleep_for(
-                std::chrono::milliseconds(milliseconds) - callbackTime);
+            std::lock_guard<std::mutex> lock{ throttleMutex_ };
+            if (!throttlePending_)
+            { // stopped
+              return;
             }
+            callback = std::move(throttled_);
+            throttled_ = nullptr;
+            throttlePending_ = false;
+            lastThrottled_ = TimerService::Clock::now();
+          }
+          callback();
+        });
+    }
+
+    // Stop the timer, waiting for a running callback unless called from it
+    void stop()
+    {
+      remove_(true);
+    }
+
+    // Stop the timer without waiting for a running callback
+    void cancel()
+    {
+      remove_(false);
+    }
 
-            // Record the start time
-            auto start{ std::chrono::high_resolution_clock::now() };
+    // Check if the timer is running (one-shot timers stop when called)
+    bool isRunning() const
+    {
+      const TimerService::Id id{ id_.load() };
+      return id != 0 && service_.contains(id);
+    }
 
-            // Call the callback function
-            callback();
+    // Set the overrun policy used by the next `start()`
+    void setOverrunPolicy(OverrunPolicy policy)
+    {
+      policy_ = policy;
+    }
 
-            // Record the end time
-            auto end{ std::chrono::high_resolution_clock::now() };
+    // Get the scheduling statistics
+    Stats getStats() const
+    {
+      const uint64_t ticks{ counters_->ticks.load(std::memory_order_relaxed) };
+      const int64_t totalJitterNs{
+        counters_->totalJitterNs.load(std::memory_order_relaxed) };
+      return Stats{
+        ticks,
+        counters_->missedDeadlines.load(std::memory_order_relaxed),
+        std::chrono::nanoseconds(counters_->maxJitterNs.load(std::memory_order_relaxed)),
+        std::chrono::nanoseconds(ticks > 0 ? totalJitterNs / static_cast<int64_t>(ticks) : 0) };
+    }
 
-            // Calculate the time taken by the callback function
-            callbackTime = std::chrono::duration_cast<
-              std::chrono::milliseconds>(end - start);
-          }
-        });
+    // Set the executor used by the next `start()`
+    void setExecutor(Executor executor)
+    {
+      executor_ = std::move(executor);
     }
 
-    // Stop the timer
-    void stop()
+  private:
+    void schedule_(std::chrono::microseconds period, bool repeat, Callback callback)
     {
-      running_ = false;
-      if (thread_.joinable() && std::this_thread::get_id() != thread_.get_id())
-      { // join the thread if it is not the current thread
-        thread_.join();
-        thread_ = std::thread{};
+      // Callbacks of the previous schedule still queued in the executor are
+      //  skipped
+      invalidateQueued_();
+
+      if (executor_)
+      { // Wrap the callback so it is delivered through the executor
+        alive_ = std::make_shared<std::atomic<bool>>(true);
+        callback =
+          [executor = executor_, alive = alive_, callback = std::move(callback)]()
+          {
+            executor([alive, callback]()
+              {
+                if (*alive)
+                {
+                  callback();
+                }
+              });
+          };
+      }
+
+      // Rearm the running timer in place, or schedule it in the shared timer
+      //  thread
+      counters_ = std::make_shared<TimerService::Counters>();
+      const TimerService::Id id{ id_.load() };
+      if (id == 0 || !service_.rearm(id, period, repeat, policy_, callback, counters_))
+      {
+        id_ = service_.add(period, repeat, policy_, std::move(callback), counters_);
       }
     }
 
-    // Check if the timer is running
-    bool isRunning() const
+    void invalidateQueued_()
+    {
+      if (alive_)
+      {
+        *alive_ = false;
+        alive_.reset();
+      }
+    }
+
+    void remove_(bool wait)
     {
-      return running_;
+      invalidateQueued_();
+      {
+        std::lock_guard<std::mutex> lock{ throttleMutex_ };
+        throttled_ = nullptr;
+        throttlePending_ = false;
+      }
+      const TimerService::Id id{ id_.exchange(0) };
+      if (id != 0)
+      {
+        service_.remove(id, wait);
+      }
     }
   };
 
@@ -0,0 +1,223 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#include "TimerService.hpp"
+
+namespace timer
+{
+  TimerService& TimerService::getInstance()
+  {
+    static TimerService* instance{ new TimerService() };
+    return *instance;
+  }
+
+  TimerService::TimerService() :
+    mutex_{},
+    scheduleChanged_{},
+    entries_{},
+    deadlines_{},
+    nextId_{ 1 },
+    runningId_{ 0 },
+    threadId_{}
+  {
+  }
+
+  TimerService::Id TimerService::add(Clock::duration period, bool repeat,
+    Timer::OverrunPolicy policy, Timer::Callback callback,
+    std::shared_ptr<Counters> counters)
+  {
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    const Id id{ nextId_++ };
+    entries_.emplace(id, Entry{ period, repeat, policy,
+      std::make_shared<Timer::Callback>(std::move(callback)),
+      std::move(counters), 0 });
+    if (threadId_ == std::thread::id{})
+    { // start the thread with the first timer
+      std::thread thread{ &TimerService::run_, this };
+      threadId_ = thread.get_id();
+      thread.detach();
+    }
+    schedule_(Deadline{ Clock::now() + period, id, 0 });
+    return id;
+  }
+
+  bool TimerService::rearm(Id id, Clock::duration period, bool repeat,
+    Timer::OverrunPolicy policy, Timer::Callback callback,
+    std::shared_ptr<Counters> counters)
+  {
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    auto it{ entries_.find(id) };
+    if (it == entries_.end())
+    {
+      return false;
+    }
+    Entry& entry{ it->second };
+    entry.period = period;
+    entry.repeat = repeat;
+    entry.policy = policy;
+    entry.callback = std::make_shared<Timer::Callback>(std::move(callback));
+    entry.counters = std::move(counters);
+    ++entry.generation;
+    schedule_(Deadline{ Clock::now() + period, id, entry.generation });
+    return true;
+  }
+
+  bool TimerService::contains(Id id)
+  {
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    return entries_.find(id) != entries_.end();
+  }
+
+  void TimerService::remove(Id id, bool wait)
+  {
+    {
+      std::lock_guard<std::mutex> lock{ mutex_ };
+      if (entries_.erase(id) > 0)
+      {
+        compactDeadlines_();
+      }
+    }
+    if (wait && std::this_thread::get_id() != threadId_)
+    { // wait for the running callback, unless we are inside it
+      Id runningId{ runningId_.load(std::memory_order_acquire) };
+      while (runningId == id)
+      {
+        runningId_.wait(runningId, std::memory_order_acquire);
+        runningId = runningId_.load(std::memory_order_acquire);
+      }
+    }
+  }
+
+  void TimerService::schedule_(const Deadline& deadline)
+  {
+    const bool earliest{ deadlines_.empty() || deadline.time < deadlines_.front().time };
+    pushDeadline_(deadline);
+    compactDeadlines_();
+    if (earliest)
+    {
+      scheduleChanged_.notify_one();
+    }
+  }
+
+  void TimerService::compactDeadlines_()
+  {
+    // Each entry has at most one live deadline
+    if (deadlines_.size() <= 2 * entries_.size())
+    {
+      return;
+    }
+    deadlines_.erase(std::remove_if(deadlines_.begin(), deadlines_.end(),
+      [this](const Deadline& deadline) { return isStale_(deadline); }),
+      deadlines_.end());
+    std::make_heap(deadlines_.begin(), deadlines_.end(), std::greater<Deadline>{});
+  }
+
+  bool TimerService::isStale_(const Deadline& deadline) const
+  {
+    auto it{ entries_.find(deadline.id) };
+    return it == entries_.end() || it->second.generation != deadline.generation;
+  }
+
+  void TimerService::pushDeadline_(const Deadline& deadline)
+  {
+    deadlines_.push_back(deadline);
+    std::push_heap(deadlines_.begin(), deadlines_.end(), std::greater<Deadline>{});
+  }
+
+  void TimerService::popDeadline_()
+  {
+    std::pop_heap(deadlines_.begin(), deadlines_.end(), std::greater<Deadline>{});
+    deadlines_.pop_back();
+  }
+
+  void TimerService::run_()
+  {
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    while (true)
+    {
+      if (deadlines_.empty())
+      {
+        scheduleChanged_.wait(lock);
+        continue;
+      }
+
+      const Deadline next{ deadlines_.front() };
+      auto it{ entries_.find(next.id) };
+      if (it == entries_.end() || it->second.generation != next.generation)
+      { // timer was removed or rearmed
+        popDeadline_();
+        continue;
+      }
+
+      if (Clock::now() < next.time)
+      { // sleep until the deadline, or until a timer is added
+        scheduleChanged_.wait_until(lock, next.time);
+        continue;
+      }
+      popDeadline_();
+
+      // Record how late the callback is
+      Counters& counters{ *it->second.counters };
+      const int64_t jitterNs{ std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - next.time).count() };
+      counters.ticks.fetch_add(1, std::memory_order_relaxed);
+      counters.totalJitterNs.fetch_add(jitterNs, std::memory_order_relaxed);
+      if (jitterNs > counters.maxJitterNs.load(std::memory_order_relaxed))
+      {
+        counters.maxJitterNs.store(jitterNs, std::memory_order_relaxed);
+      }
+
+      // Run the callback without holding the lock, so it can start or stop
+      //  timers
+      const std::shared_ptr<Timer::Callback> callback{ it->second.callback };
+      if (!it->second.repeat)
+      { // one-shot, it can be added again from its own callback
+        entries_.erase(it);
+      }
+      runningId_.store(next.id, std::memory_order_release);
+      lock.unlock();
+      (*callback)();
+      runningId_.store(0, std::memory_order_release);
+      runningId_.notify_all();
+      lock.lock();
+
+      // Reschedule relative to the deadline, not to the wakeup time. A timer
+      //  rearmed by its callback already has its new deadline.
+      it = entries_.find(next.id);
+      if (it != entries_.end() && it->second.generation == next.generation)
+      {
+        pushDeadline_(Deadline{ nextDeadline_(it->second, next.time, Clock::now()),
+          next.id, next.generation });
+      }
+    }
+  }
+
+  TimerService::Clock::time_point TimerService::nextDeadline_(
+    const Entry& entry, Clock::time_point deadline, Clock::time_point now)
+  {
+    Clock::time_point next{ deadline + entry.period };
+    if (next > now)
+    {
+      return next;
+    }
+
+    // Overrun: the next deadline has already passed
+    const uint64_t missed{ static_cast<uint64_t>((now - next) / entry.period) + 1 };
+    switch (entry.policy)
+    {
+    case Timer::OverrunPolicy::Skip:
+      next += entry.period * static_cast<Clock::rep>(missed);
+      entry.counters->missedDeadlines.fetch_add(missed, std::memory_order_relaxed);
+      break;
+    case Timer::OverrunPolicy::CatchUp:
+      entry.counters->missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case Timer::OverrunPolicy::Coalesce:
+      next = now;
+      entry.counters->missedDeadlines.fetch_add(missed, std::memory_order_relaxed);
+      break;
+    }
+    return next;
+  }
+
+} // namespace timer
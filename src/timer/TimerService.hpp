@@ -0,0 +1,122 @@
+//  Copyright (c) 2025 Daniel Moreno. All rights reserved.
+//
+
+#pragma once
+
+#include <timer/Timer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace timer
+{
+  // Shared timer service
+  // --------------------
+  // A single thread, started with the first timer, runs the callbacks of all
+  // the timers of the process. Deadlines are kept in a min-heap and the thread
+  // sleeps on a condition variable until the earliest one, so the number of
+  // threads does not depend on the number of timers. Deadlines are absolute
+  // `steady_clock` time points, each one a period after the previous one. Callbacks run one at a
+  // time: a slow callback delays the others (use `Timer::setExecutor()` to
+  // move heavy work elsewhere).
+  class TimerService
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Id = uint64_t;
+
+    // Statistics of a timer, updated by the service thread
+    struct Counters
+    {
+      std::atomic<uint64_t> ticks{ 0 };
+      std::atomic<uint64_t> missedDeadlines{ 0 };
+      std::atomic<int64_t> maxJitterNs{ 0 };
+      std::atomic<int64_t> totalJitterNs{ 0 };
+    };
+
+    // The service is never destroyed, so timers can be stopped at any point
+    //  during program exit
+    static TimerService& getInstance();
+
+    // Schedule a callback, the first call happens after `period`. One-shot
+    //  callbacks (`repeat` false) are unscheduled when they are called.
+    Id add(Clock::duration period, bool repeat, Timer::OverrunPolicy policy,
+      Timer::Callback callback, std::shared_ptr<Counters> counters);
+
+    // Replace the period, policy and callback of a scheduled timer and restart
+    //  its period from now. Does not wait for a running callback. Returns
+    //  false if `id` is not scheduled.
+    bool rearm(Id id, Clock::duration period, bool repeat,
+      Timer::OverrunPolicy policy, Timer::Callback callback,
+      std::shared_ptr<Counters> counters);
+
+    // Check if a callback is scheduled
+    bool contains(Id id);
+
+    // Unschedule a callback. If the callback is running and `wait` is set,
+    //  waits for it to complete unless called from the callback itself.
+    void remove(Id id, bool wait = true);
+
+  private:
+    struct Entry
+    {
+      Clock::duration period;
+      bool repeat;
+      Timer::OverrunPolicy policy;
+      std::shared_ptr<Timer::Callback> callback;
+      std::shared_ptr<Counters> counters;
+      // Incremented on rearm, to discard the deadlines of the old schedule
+      uint64_t generation;
+    };
+
+    struct Deadline
+    {
+      Clock::time_point time;
+      Id id;
+      uint64_t generation;
+
+      bool operator>(const Deadline& other) const { return time > other.time; }
+    };
+
+    TimerService();
+    ~TimerService() = delete;
+
+    void run_();
+
+    // Push a deadline and wake the thread if it is the earliest one
+    void schedule_(const Deadline& deadline);
+
+    // Drop the deadlines of removed or rearmed timers once they outnumber the
+    //  live ones, so stopping and rearming timers does not grow the heap
+    void compactDeadlines_();
+    bool isStale_(const Deadline& deadline) const;
+
+    void pushDeadline_(const Deadline& deadline);
+    void popDeadline_();
+
+    // Get the deadline that follows `deadline`, applying the overrun policy
+    static Clock::time_point nextDeadline_(
+      const Entry& entry, Clock::time_point deadline, Clock::time_point now);
+
+    std::mutex mutex_;
+    std::condition_variable scheduleChanged_;
+    std::unordered_map<Id, Entry> entries_;
+    // Min-heap (`std::greater`). Deadlines of removed or rearmed entries are
+    //  skipped when they expire, or dropped by `compactDeadlines_()`.
+    std::vector<Deadline> deadlines_;
+    Id nextId_;
+    // Id of the running callback, waited on (futex) by `remove()`
+    std::atomic<Id> runningId_;
+    // The thread is detached, keep its id to detect calls from callbacks
+    std::thread::id threadId_;
+  };
+
+} // namespace timer